@@ -0,0 +1,113 @@
+/**
+ * @author nawww83@gmail.com
+ * @brief Редукция Барретта: многократное взятие остатка по фиксированному модулю без деления.
+ */
+
+#pragma once
+
+#include <cassert>
+#include "u128.hpp"
+#include "ubig.hpp"
+
+namespace bignum
+{
+
+    /**
+     * @brief Редуктор Барретта для 128-битного модуля m (четного или нечетного).
+     * @details Заранее вычисляется mu = floor(2^256 / m). Оценка частного q = floor(x * mu / 2^256)
+     * отличается от истинного не более чем на единицу, поэтому остаток получается
+     * умножениями и не более чем одним вычитанием модуля.
+     */
+    class BarrettReducer
+    {
+        using U128 = u128::U128;
+        using U256 = UBig<U128>;
+
+        /**
+         * @brief Модуль m.
+         */
+        U128 mM;
+
+        /**
+         * @brief Величина mu = floor(2^256 / m). Для m = 1 берется 2^256 - 1, что сохраняет оценку частного.
+         */
+        U256 mMu;
+
+    public:
+        /**
+         * @brief Конструктор.
+         * @param m Модуль, не равный нулю.
+         */
+        explicit BarrettReducer(const U128 &m) : mM{m}
+        {
+            assert(m != U128{0});
+            mMu = (m == U128{1}) ? U256::max() : bignum::generic::reciprocal_and_extend(U256{m}).first;
+        }
+
+        /**
+         * @brief Модуль.
+         */
+        [[nodiscard]] constexpr const U128 &modulus() const noexcept { return mM; }
+
+        /**
+         * @brief Остаток от деления 128-битного числа: x mod m.
+         */
+        [[nodiscard]] constexpr U128 reduce(const U128 &x) const noexcept
+        {
+            if (x < mM)
+                return x;
+            // q = floor(x * mu / 2^256), x * mu = x * mu_low + 2^128 * x * mu_high.
+            const auto [a_low, a_high] = u128::mult_full(x, mMu.low());
+            const auto [b_low, b_high] = u128::mult_full(x, mMu.high());
+            const U128 mid = a_high + b_low;
+            const U128 q = b_high + U128{mid < a_high ? 1ull : 0ull};
+            // Истинный остаток не превосходит x, поэтому его можно считать по модулю 2^128.
+            U128 r = x - q * mM;
+            if (r >= mM)
+                r -= mM;
+            return r;
+        }
+
+        /**
+         * @brief Остаток от деления 256-битного числа (например, результата U256::mult_ext): x mod m.
+         */
+        [[nodiscard]] constexpr U128 reduce(const U256 &x) const noexcept
+        {
+            if (x.high() == U128{0})
+                return reduce(x.low());
+            // q = старшие 256 бит произведения x * mu (4 произведения 128x128).
+            const auto [a_low, a_high] = u128::mult_full(x.low(), mMu.low());
+            const auto [b_low, b_high] = u128::mult_full(x.low(), mMu.high());
+            const auto [c_low, c_high] = u128::mult_full(x.high(), mMu.low());
+            const auto [d_low, d_high] = u128::mult_full(x.high(), mMu.high());
+            U128 p1 = a_high + b_low;
+            unsigned c1 = p1 < a_high ? 1u : 0u;
+            p1 += c_low;
+            c1 += p1 < c_low ? 1u : 0u;
+            U128 p2 = b_high + c_high;
+            unsigned c2 = p2 < b_high ? 1u : 0u;
+            p2 += d_low;
+            c2 += p2 < d_low ? 1u : 0u;
+            p2 += U128{c1};
+            c2 += p2 < U128{c1} ? 1u : 0u;
+            const U128 p3 = d_high + U128{c2};
+            // r = x - q * m по модулю 2^256: истинный остаток меньше 2m.
+            const auto [qm_low, qm_high] = u128::mult_full(p2, mM);
+            const U256 qm{qm_low, qm_high + p3 * mM};
+            U256 r = x - qm;
+            if (r >= U256{mM})
+                r -= U256{mM};
+            return r.low();
+        }
+
+        /**
+         * @brief Произведение по модулю: (x * y) mod m.
+         */
+        [[nodiscard]] constexpr U128 mul(const U128 &x, const U128 &y) const noexcept
+        {
+            const auto [low, high] = u128::mult_full(x, y);
+            return reduce(U256{low, high});
+        }
+    };
+
+} // namespace bignum
@@ -0,0 +1,172 @@
+/**
+ * @author nawww83@gmail.com
+ * @brief Быстрые десятичные преобразования: разбор цифр (SWAR по 8 цифр в uint64_t и SSE4.1 по 16 цифр)
+ * и запись цифр парами по таблице.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include "defines.h"
+
+#if defined(__SSE4_1__)
+#define USE_SSE41_DECIMAL_PARSER
+#include <immintrin.h>
+#endif
+
+namespace bignum::detail
+{
+    /**
+     * @brief Степени десяти 10^0 ... 10^19, помещающиеся в 64 бита.
+     */
+    inline constexpr uint64_t POW10[20]{
+        1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+        1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+        100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+        1000000000000000000ull, 10000000000000000000ull};
+
+    /**
+     * @brief Наибольшее количество цифр, обрабатываемое за один блок (10^19 < 2^64).
+     */
+    inline constexpr int DECIMAL_BLOCK_DIGITS = 19;
+
+    /**
+     * @brief Является ли символ десятичной цифрой.
+     */
+    inline constexpr bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+    /**
+     * @brief Загрузка 8 символов в uint64_t (младший байт - первый символ).
+     * Компилятор сводит цикл к одной невыровненной загрузке.
+     */
+    inline constexpr uint64_t load_eight_chars(const char *p) noexcept
+    {
+        uint64_t v = 0;
+        for (int i = 0; i < 8; ++i)
+            v |= static_cast<uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+        return v;
+    }
+
+    /**
+     * @brief Проверка, что все 8 байт - символы '0'...'9'.
+     * @details Старшая тетрада каждого байта должна быть равна 3, и прибавление 6 не должно ее изменять.
+     */
+    inline constexpr bool is_eight_digits(uint64_t chunk) noexcept
+    {
+        return ((chunk & 0xF0F0F0F0F0F0F0F0ull) |
+                (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+    }
+
+    /**
+     * @brief Преобразование 8 цифр в число за три умножения (SWAR).
+     * @details Сначала соседние цифры объединяются в байтах в числа 0..99, затем
+     * две пары умножений собирают из них 32-битный результат.
+     */
+    inline constexpr uint64_t parse_eight_digits(uint64_t chunk) noexcept
+    {
+        constexpr uint64_t MASK = 0x000000FF000000FFull;
+        constexpr uint64_t MUL1 = 100 + (1000000ull << 32);
+        constexpr uint64_t MUL2 = 1 + (10000ull << 32);
+        chunk -= 0x3030303030303030ull;
+        chunk = (chunk * 10) + (chunk >> 8);
+        chunk = (((chunk & MASK) * MUL1) + (((chunk >> 16) & MASK) * MUL2)) >> 32;
+        return chunk & 0xFFFFFFFFull;
+    }
+
+#if defined(USE_SSE41_DECIMAL_PARSER)
+    /**
+     * @brief Проверка и преобразование 16 цифр за один проход SSE4.1.
+     * @return false, если среди 16 символов есть не цифра.
+     */
+    inline bool parse_sixteen_digits_sse(const char *p, uint64_t &value) noexcept
+    {
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        const __m128i bad = _mm_or_si128(_mm_cmplt_epi8(chars, _mm_set1_epi8('0')),
+                                         _mm_cmpgt_epi8(chars, _mm_set1_epi8('9')));
+        if (_mm_movemask_epi8(bad) != 0)
+            return false;
+        const __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+        // Пары цифр -> 16-битные числа 0..99.
+        const __m128i t1 = _mm_maddubs_epi16(digits, _mm_set1_epi16(0x010A));
+        // Четверки цифр -> 32-битные числа 0..9999.
+        const __m128i t2 = _mm_madd_epi16(t1, _mm_set1_epi32(0x00010064));
+        // Восьмерки цифр -> 32-битные числа 0..99999999 в двух младших словах.
+        const __m128i t3 = _mm_packus_epi32(t2, t2);
+        const __m128i t4 = _mm_madd_epi16(t3, _mm_set1_epi32(0x00012710));
+        const uint64_t hi = static_cast<uint32_t>(_mm_cvtsi128_si32(t4));
+        const uint64_t lo = static_cast<uint32_t>(_mm_extract_epi32(t4, 1));
+        value = hi * 100000000ull + lo;
+        return true;
+    }
+#endif
+
+    /**
+     * @brief Разбор блока из не более чем 19 цифр, начиная с p.
+     * @param value Значение разобранных цифр.
+     * @return Указатель на первый символ после блока: либо на первую не цифру, либо через 19 цифр, либо last.
+     */
+    inline constexpr const char *parse_decimal_block(const char *p, const char *last, uint64_t &value) noexcept
+    {
+        const char *const end = (last - p > DECIMAL_BLOCK_DIGITS) ? p + DECIMAL_BLOCK_DIGITS : last;
+        uint64_t v = 0;
+#if defined(USE_SSE41_DECIMAL_PARSER)
+        if (!std::is_constant_evaluated() && end - p >= 16)
+        {
+            if (parse_sixteen_digits_sse(p, v))
+                p += 16;
+        }
+#endif
+        while (end - p >= 8)
+        {
+            const uint64_t chunk = load_eight_chars(p);
+            if (!is_eight_digits(chunk))
+                break;
+            v = v * 100000000ull + parse_eight_digits(chunk);
+            p += 8;
+        }
+        for (; p != end && is_digit(*p); ++p)
+            v = v * 10 + static_cast<uint64_t>(*p - '0');
+        value = v;
+        return p;
+    }
+
+    /**
+     * @brief Количество десятичных цифр 64-битного числа (для нуля - одна цифра).
+     */
+    inline constexpr int count_digits(uint64_t v) noexcept
+    {
+        int n = 1;
+        for (;;)
+        {
+            if (v < 10)
+                return n;
+            if (v < 100)
+                return n + 1;
+            if (v < 1000)
+                return n + 2;
+            if (v < 10000)
+                return n + 3;
+            v /= 10000;
+            n += 4;
+        }
+    }
+
+    /**
+     * @brief Записывает ровно n младших десятичных цифр числа v справа налево, заканчивая перед end.
+     * Цифры формируются парами по таблице DIGIT_PAIRS.
+     */
+    inline constexpr void write_digits(char *end, uint64_t v, int n) noexcept
+    {
+        for (; n >= 2; n -= 2)
+        {
+            const auto i = static_cast<size_t>(v % 100) * 2;
+            v /= 100;
+            *--end = DIGIT_PAIRS[i + 1];
+            *--end = DIGIT_PAIRS[i];
+        }
+        if (n > 0)
+            *--end = DIGITS[v % 10];
+    }
+}
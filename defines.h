@@ -3,4 +3,19 @@
 /**
  * Массив для формирования цифр по индексам.
  */
-inline constexpr char DIGITS[10]{'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'};
\ No newline at end of file
+inline constexpr char DIGITS[10]{'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+/**
+ * Массив пар цифр "00", "01", ..., "99" для формирования двух цифр за одну операцию по индексу 2 * (x mod 100).
+ */
+inline constexpr char DIGIT_PAIRS[201]{
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899"};
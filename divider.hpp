@@ -0,0 +1,117 @@
+/**
+ * @author nawww83@gmail.com
+ * @brief Деление на инвариантный делитель через "магическое" число (умножение на обратную величину и сдвиг).
+ */
+
+#pragma once
+
+#include <cassert>
+#include <utility>
+#include "u128.hpp"
+#include "ubig.hpp"
+
+namespace bignum
+{
+
+    namespace detail
+    {
+        /**
+         * @brief Старшая половина произведения двух чисел одинаковой разрядности.
+         */
+        template <typename T>
+        inline constexpr T mulhi(const T &x, const T &y) noexcept
+        {
+            if constexpr (std::is_same_v<T, u128::U128>)
+                return u128::mulhi(x, y);
+            else
+                return T::mulhi(x, y);
+        }
+    }
+
+    /**
+     * @brief Делитель, подготовленный для многократного деления на одно и то же число d.
+     * @details Метод Гранлунда-Монтгомери: для N-битного типа и l = ceil(log2(d))
+     * заранее вычисляется множитель m = floor(2^N * (2^l - d) / d) + 1, после чего
+     * q = (t + ((n - t) >> 1)) >> (l - 1), где t = mulhi(m, n). Точно для любых n и d >= 1.
+     * @tparam T Тип чисел (U128, U256, U512, ...).
+     */
+    template <typename T>
+    class Divider
+    {
+        /**
+         * @brief Делитель d.
+         */
+        T mD{0};
+
+        /**
+         * @brief Множитель m.
+         */
+        T mMagic{0};
+
+        /**
+         * @brief Величина l = ceil(log2(d)).
+         */
+        uint32_t mLog{0};
+
+        /**
+         * @brief Признак делителя - степени двойки (деление сводится к сдвигу на mLog).
+         */
+        bool mIsPow2{false};
+
+    public:
+        static constexpr uint32_t WIDTH = static_cast<uint32_t>(bignum::generic::bit_size<T>());
+
+        /**
+         * @brief Конструктор.
+         * @param d Делитель, не равный нулю.
+         */
+        constexpr explicit Divider(const T &d) : mD{d}
+        {
+            assert(d != T{0});
+            T d_minus_1 = d;
+            --d_minus_1;
+            mLog = WIDTH - static_cast<uint32_t>(bignum::generic::countl_zero_generic(d_minus_1));
+            mIsPow2 = (d & d_minus_1) == T{0};
+            if (mIsPow2)
+                return;
+            // (2^l - d) вычисляется по модулю 2^N: при l = N сдвиг дает ноль.
+            const T numerator_high = (T{1} << mLog) - d;
+            mMagic = UBig<T>::template divide<true, false>(UBig<T>{T{0}, numerator_high}, d, nullptr).low();
+            ++mMagic;
+        }
+
+        /**
+         * @brief Делитель.
+         */
+        [[nodiscard]] constexpr const T &divisor() const noexcept { return mD; }
+
+        /**
+         * @brief Частное n / d.
+         */
+        [[nodiscard]] constexpr T quot(const T &n) const noexcept
+        {
+            if (mIsPow2)
+                return n >> mLog;
+            const T t = detail::mulhi(mMagic, n);
+            return (t + ((n - t) >> 1)) >> (mLog - 1);
+        }
+
+        /**
+         * @brief Остаток n mod d.
+         */
+        [[nodiscard]] constexpr T rem(const T &n) const noexcept
+        {
+            return n - quot(n) * mD;
+        }
+
+        /**
+         * @brief Частное и остаток в виде пары.
+         */
+        [[nodiscard]] constexpr std::pair<T, T> divrem(const T &n) const noexcept
+        {
+            const T q = quot(n);
+            return {q, n - q * mD};
+        }
+    };
+
+} // namespace bignum
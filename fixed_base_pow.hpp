@@ -0,0 +1,128 @@
+/**
+ * @author nawww83@gmail.com
+ * @brief Возведение фиксированного основания в степень по модулю с предвычисленной таблицей (гребенка Лима-Ли).
+ */
+
+#pragma once
+
+#include <cassert>
+#include <algorithm>
+#include <vector>
+#include "u128.hpp"
+#include "ubig.hpp"
+#include "montgomery.hpp"
+
+namespace bignum
+{
+
+    /**
+     * @brief Возведение в степень фиксированного основания g по фиксированному нечетному модулю N.
+     * @details Гребенка Лима-Ли с одним блоком: показатель длиной до h * a бит раскладывается на h строк по a бит,
+     * и для каждого набора s из h бит заранее вычисляется G[s] = prod_{j: s_j = 1} g^(2^(j * a)) в форме Монтгомери.
+     * Тогда g^e получается за a - 1 возведений в квадрат и не более a умножений на элементы таблицы
+     * вместо примерно log2(e) квадратов в обычном возведении в степень.
+     * @tparam T Тип чисел (U128 или UBig любой разрядности).
+     */
+    template <typename T>
+    class FixedBasePow
+    {
+        /**
+         * @brief Контекст Монтгомери по модулю N.
+         */
+        MontgomeryContext<T> mCtx;
+
+        /**
+         * @brief Число "зубьев" гребенки h (строк показателя); таблица из 2^h элементов.
+         */
+        uint32_t mTeeth;
+
+        /**
+         * @brief Расстояние между зубьями a (длина строки показателя в битах).
+         */
+        uint32_t mSpacing;
+
+        /**
+         * @brief Таблица G[s], s = 0 ... 2^h - 1, в форме Монтгомери.
+         */
+        std::vector<T> mTable;
+
+    public:
+        static constexpr uint32_t WIDTH = static_cast<uint32_t>(bignum::generic::bit_size<T>());
+
+        /**
+         * @brief Конструктор: предвычисление таблицы.
+         * @param base Основание g.
+         * @param modulus Нечетный модуль N.
+         * @param max_exp_bits Наибольшая битовая длина показателя.
+         * @param teeth Число зубьев h (0 - выбор по max_exp_bits: 8 для показателей от 128 бит, таблица 256 элементов).
+         */
+        FixedBasePow(const T &base, const T &modulus, uint32_t max_exp_bits = WIDTH, uint32_t teeth = 0)
+            : mCtx{modulus}
+        {
+            assert(max_exp_bits > 0);
+            mTeeth = teeth != 0 ? teeth : std::clamp(max_exp_bits / 16, 1u, 8u);
+            assert(mTeeth < 32);
+            mSpacing = (max_exp_bits + mTeeth - 1) / mTeeth;
+            mTable.resize(size_t{1} << mTeeth);
+            mTable[0] = mCtx.one();
+            // g^(2^(j * a)) кладется в G[2^j], остальные элементы - произведения по старшему биту индекса.
+            T power = mCtx.to_mont(base);
+            for (uint32_t j = 0; j < mTeeth; ++j)
+            {
+                mTable[size_t{1} << j] = power;
+                if (j + 1 < mTeeth)
+                    for (uint32_t i = 0; i < mSpacing; ++i)
+                        power = mCtx.sqr(power);
+            }
+            for (size_t s = 1; s < mTable.size(); ++s)
+            {
+                const size_t top = size_t{1} << (std::bit_width(s) - 1);
+                if (s != top)
+                    mTable[s] = mCtx.mul(mTable[s - top], mTable[top]);
+            }
+        }
+
+        /**
+         * @brief Модуль.
+         */
+        [[nodiscard]] const T &modulus() const noexcept { return mCtx.modulus(); }
+
+        /**
+         * @brief Наибольшая битовая длина показателя: h * a.
+         */
+        [[nodiscard]] uint32_t max_exp_bits() const noexcept { return mTeeth * mSpacing; }
+
+        /**
+         * @brief Степень g^e mod N.
+         * @param e Показатель, не длиннее max_exp_bits() бит.
+         */
+        [[nodiscard]] T pow(const T &e) const
+        {
+            assert(e.bit_width() <= max_exp_bits());
+            const auto words = detail::to_words(e);
+            const uint32_t bits = e.bit_width();
+            T result = mCtx.one();
+            bool started = false;
+            for (uint32_t i = mSpacing; i-- > 0;)
+            {
+                if (started)
+                    result = mCtx.sqr(result);
+                // Индекс собирается без ветвлений: биты показателя непредсказуемы.
+                size_t s = 0;
+                for (uint32_t j = 0; j < mTeeth; ++j)
+                {
+                    const uint32_t position = j * mSpacing + i;
+                    const uint64_t word = position < bits ? words[position / 64] >> (position % 64) : 0;
+                    s |= static_cast<size_t>(word & 1ull) << j;
+                }
+                if (s == 0)
+                    continue;
+                // Первое ненулевое окно: возведение единицы в квадрат не нужно.
+                result = started ? mCtx.mul(result, mTable[s]) : mTable[s];
+                started = true;
+            }
+            return mCtx.from_mont(result);
+        }
+    };
+
+} // namespace bignum
@@ -539,16 +539,56 @@ namespace bignum::i128
          */
         [[nodiscard]] std::string toString() const
         {
-            if (mSingular.is_nan()) return "nan";
-            if (mSingular.is_overflow()) return "inf";
-            if (mUnsigned == U128{0}) return "0";
-
-            std::string res = mUnsigned.toString();
-            if (mSign()) {
-                // Чтобы избежать лишних копирований, можно использовать конкатенацию,
-                // но большинство современных компиляторов оптимизируют это.
-                return "-" + res; 
+            char buf[40]; // Знак и 39 цифр.
+            const auto [ptr, ec] = to_chars(buf, buf + sizeof(buf), *this);
+            return std::string(buf, ptr);
+        }
+
+        /**
+         * @brief Запись числа в буфер [first, last) по контракту std::to_chars. Без аллокаций.
+         * @details Сингулярные числа записываются как "nan" и "inf".
+         */
+        friend std::to_chars_result to_chars(char *first, char *last, const I128 &value) noexcept
+        {
+            const char *special = value.mSingular.is_nan() ? "nan" : (value.mSingular.is_overflow() ? "inf" : nullptr);
+            if (special)
+            {
+                if (last - first < 3)
+                    return {last, std::errc::value_too_large};
+                std::copy(special, special + 3, first);
+                return {first + 3, std::errc{}};
+            }
+            if (value.is_negative())
+            {
+                if (first == last)
+                    return {last, std::errc::value_too_large};
+                *first++ = '-';
+            }
+            return bignum::u128::to_chars(first, last, value.mUnsigned);
+        }
+
+        /**
+         * @brief Чтение числа из [first, last) по контракту std::from_chars: необязательный "-" и цифры, либо "nan"/"inf".
+         */
+        friend std::from_chars_result from_chars(const char *first, const char *last, I128 &value) noexcept
+        {
+            const std::string_view s(first, static_cast<size_t>(last - first));
+            if (s.starts_with("nan") || s.starts_with("inf"))
+            {
+                value = I128{0};
+                if (s[0] == 'n')
+                    value.set_nan();
+                else
+                    value.set_overflow();
+                return {first + 3, std::errc{}};
             }
+            const bool negative = first != last && *first == '-';
+            U128 x;
+            const auto res = bignum::u128::from_chars(first + (negative ? 1 : 0), last, x);
+            if (res.ec == std::errc::invalid_argument)
+                return {first, res.ec};
+            if (res.ec == std::errc{})
+                value = I128{x, negative && x != U128{0}};
             return res;
         }
 
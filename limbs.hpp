@@ -0,0 +1,1394 @@
+/**
+ * @author nawww83@gmail.com
+ * @brief Базовые операции над "плоским" представлением длинных чисел: массивом 64-битных слов (limbs),
+ * младшее слово первое.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <bit>
+#include <type_traits>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "u128.hpp"
+#include "decimal.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define USE_X86_CARRY_INTRINSICS
+#define USE_X86_ADX_KERNELS
+#include <x86intrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define USE_X86_CARRY_INTRINSICS
+#include <intrin.h>
+#endif
+
+namespace bignum::limbs
+{
+    using u64 = uint64_t;
+
+#if defined(USE_X86_ADX_KERNELS)
+    /**
+     * @brief Поддерживает ли процессор инструкции MULX (BMI2) и ADCX/ADOX (ADX). Определяется один раз при запуске.
+     */
+    inline const bool CPU_HAS_ADX = __builtin_cpu_supports("adx") && __builtin_cpu_supports("bmi2");
+
+    /**
+     * @brief Длина, начиная с которой r += a * k считается ядром MULX/ADCX/ADOX.
+     */
+    inline constexpr size_t ADX_ADDMUL_MIN_LIMBS = 8;
+
+    /**
+     * @brief r += a * k (n слов, n кратно 4) на MULX/ADCX/ADOX: две независимые цепочки переносов
+     * (флаг CF - старшие слова произведений, флаг OF - накопление в r), цикл развернут на 4 слова.
+     * @details Счетчик цикла меняется через lea, выход - по jrcxz: обе инструкции не трогают флаги.
+     * @param carry Входной перенос в слово r[0].
+     * @return Перенос в слово r[n].
+     */
+    __attribute__((target("adx,bmi2"))) inline u64 addmul_4k_adx(u64 *r, const u64 *a, size_t n, u64 k, u64 carry) noexcept
+    {
+        u64 lo0, hi0, lo1, hi1;
+        long count = -static_cast<long>(n / 4);
+        __asm__ volatile(
+            "xor %%eax, %%eax\n\t"
+            "1:\n\t"
+            "mulx (%[a]), %[lo0], %[hi0]\n\t"
+            "adcx %[c], %[lo0]\n\t"
+            "adox (%[r]), %[lo0]\n\t"
+            "mov %[lo0], (%[r])\n\t"
+            "mulx 8(%[a]), %[lo1], %[hi1]\n\t"
+            "adcx %[hi0], %[lo1]\n\t"
+            "adox 8(%[r]), %[lo1]\n\t"
+            "mov %[lo1], 8(%[r])\n\t"
+            "mulx 16(%[a]), %[lo0], %[hi0]\n\t"
+            "adcx %[hi1], %[lo0]\n\t"
+            "adox 16(%[r]), %[lo0]\n\t"
+            "mov %[lo0], 16(%[r])\n\t"
+            "mulx 24(%[a]), %[lo1], %[c]\n\t"
+            "adcx %[hi0], %[lo1]\n\t"
+            "adox 24(%[r]), %[lo1]\n\t"
+            "mov %[lo1], 24(%[r])\n\t"
+            "lea 32(%[a]), %[a]\n\t"
+            "lea 32(%[r]), %[r]\n\t"
+            "lea 1(%[cnt]), %[cnt]\n\t"
+            "jrcxz 2f\n\t"
+            "jmp 1b\n\t"
+            "2:\n\t"
+            "mov $0, %%eax\n\t"
+            "adcx %%rax, %[c]\n\t"
+            "adox %%rax, %[c]\n\t"
+            : [c] "+&r"(carry), [lo0] "=&r"(lo0), [hi0] "=&r"(hi0), [lo1] "=&r"(lo1), [hi1] "=&r"(hi1),
+              [cnt] "+c"(count), [a] "+r"(a), [r] "+r"(r)
+            : "d"(k)
+            : "rax", "cc", "memory");
+        return carry;
+    }
+#endif
+
+    /**
+     * @brief Длина числа без ведущих нулевых слов.
+     */
+    inline constexpr size_t normalized_size(const u64 *a, size_t n) noexcept
+    {
+        while (n > 0 && a[n - 1] == 0)
+            --n;
+        return n;
+    }
+
+    /**
+     * @brief Сравнение двух чисел одинаковой длины n.
+     */
+    inline constexpr int cmp_n(const u64 *a, const u64 *b, size_t n) noexcept
+    {
+        while (n-- > 0)
+        {
+            if (a[n] != b[n])
+                return a[n] < b[n] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief r = a + b (n слов).
+     * @return Перенос из старшего слова.
+     */
+    inline constexpr u64 add_n(u64 *r, const u64 *a, const u64 *b, size_t n) noexcept
+    {
+#if defined(USE_X86_CARRY_INTRINSICS)
+        if (!std::is_constant_evaluated())
+        {
+            unsigned char c = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                unsigned long long t;
+                c = _addcarry_u64(c, a[i], b[i], &t);
+                r[i] = t;
+            }
+            return c;
+        }
+#endif
+        u64 carry = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const u64 s = a[i] + carry;
+            carry = s < carry ? 1 : 0;
+            r[i] = s + b[i];
+            carry += r[i] < s ? 1 : 0;
+        }
+        return carry;
+    }
+
+    /**
+     * @brief r = a - b (n слов).
+     * @return Заем из старшего слова.
+     */
+    inline constexpr u64 sub_n(u64 *r, const u64 *a, const u64 *b, size_t n) noexcept
+    {
+#if defined(USE_X86_CARRY_INTRINSICS)
+        if (!std::is_constant_evaluated())
+        {
+            unsigned char c = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                unsigned long long t;
+                c = _subborrow_u64(c, a[i], b[i], &t);
+                r[i] = t;
+            }
+            return c;
+        }
+#endif
+        u64 borrow = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const u64 d = a[i] - b[i];
+            const u64 b1 = a[i] < b[i] ? 1 : 0;
+            r[i] = d - borrow;
+            borrow = b1 + (d < borrow ? 1 : 0);
+        }
+        return borrow;
+    }
+
+    /**
+     * @brief r += c (n слов) с распространением переноса.
+     * @return Перенос из старшего слова.
+     */
+    inline constexpr u64 add_1(u64 *r, size_t n, u64 c) noexcept
+    {
+        for (size_t i = 0; c != 0 && i < n; ++i)
+        {
+            r[i] += c;
+            c = r[i] < c ? 1 : 0;
+        }
+        return c;
+    }
+
+    /**
+     * @brief r = a * k (n слов).
+     * @return Старшее слово произведения.
+     */
+    inline constexpr u64 mul_1(u64 *r, const u64 *a, size_t n, u64 k) noexcept
+    {
+        u64 carry = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const u128::U128 p = u128::U128::mult_ext(a[i], k) + u128::U128{carry};
+            r[i] = p.low();
+            carry = p.high();
+        }
+        return carry;
+    }
+
+    /**
+     * @brief r += a * k (n слов), переносимая версия.
+     * @param carry Входной перенос в слово r[0].
+     * @return Перенос в слово r[n].
+     */
+    inline constexpr u64 addmul_1_generic(u64 *r, const u64 *a, size_t n, u64 k, u64 carry = 0) noexcept
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            const u128::U128 p = u128::U128::mult_ext(a[i], k) + u128::U128{carry} + u128::U128{r[i]};
+            r[i] = p.low();
+            carry = p.high();
+        }
+        return carry;
+    }
+
+    /**
+     * @brief r += a * k (n слов).
+     * @details На x86-64 с ADX/BMI2 (проверка при запуске) длинные строки считаются ядром addmul_4k_adx,
+     * "хвост" n mod 4 младших слов - переносимой версией.
+     * @return Перенос в слово r[n].
+     */
+    inline constexpr u64 addmul_1(u64 *r, const u64 *a, size_t n, u64 k) noexcept
+    {
+#if defined(USE_X86_ADX_KERNELS)
+        if (!std::is_constant_evaluated() && n >= ADX_ADDMUL_MIN_LIMBS && CPU_HAS_ADX)
+        {
+            const size_t head = n % 4;
+            const u64 carry = addmul_1_generic(r, a, head, k);
+            return addmul_4k_adx(r + head, a + head, n - head, k, carry);
+        }
+#endif
+        return addmul_1_generic(r, a, n, k);
+    }
+
+    /**
+     * @brief r -= a * k (n слов).
+     * @return Заем из слова r[n].
+     */
+    inline constexpr u64 submul_1(u64 *r, const u64 *a, size_t n, u64 k) noexcept
+    {
+        u64 borrow = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const u128::U128 p = u128::U128::mult_ext(a[i], k) + u128::U128{borrow};
+            const u64 old = r[i];
+            r[i] = old - p.low();
+            borrow = p.high() + (old < p.low() ? 1 : 0);
+        }
+        return borrow;
+    }
+
+    /**
+     * @brief r = r * k + c (n слов) одной цепочкой переносов.
+     * @return Старшее слово результата.
+     */
+    inline constexpr u64 mul_add_1(u64 *r, size_t n, u64 k, u64 c) noexcept
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            const u128::U128 p = u128::U128::mult_ext(r[i], k) + u128::U128{c};
+            r[i] = p.low();
+            c = p.high();
+        }
+        return c;
+    }
+
+    /**
+     * @brief Умножение "в столбик": r = a * b, r содержит na + nb слов и не пересекается с a и b.
+     */
+    inline constexpr void mul_basecase(u64 *r, const u64 *a, size_t na, const u64 *b, size_t nb) noexcept
+    {
+        r[na] = mul_1(r, a, na, b[0]);
+        for (size_t j = 1; j < nb; ++j)
+            r[na + j] = addmul_1(r + j, a, na, b[j]);
+    }
+
+    /**
+     * @brief "Короткое" произведение для старшей половины: r[n..2n) = floor(a * b / B^n) - e, где e - 0 или 1.
+     * @details Операнды по n слов, r из 2n слов, как у mul_basecase, но вычисляются только слова начиная с n - 2:
+     * отбрасываются частичные произведения a[i] * b[j] с i + j < n - 2 (примерно половина при больших n).
+     * Их сумма меньше (n - 2) * B^(n - 1) < B^n, поэтому старшая половина занижена не более чем на единицу.
+     * При n < 3 произведение вычисляется полностью (e = 0).
+     */
+    inline constexpr void mulhi_basecase(u64 *r, const u64 *a, const u64 *b, size_t n) noexcept
+    {
+        if (n < 3)
+        {
+            mul_basecase(r, a, n, b, n);
+            return;
+        }
+        // Строка i содержит a[i] * b[j] при j >= n - 2 - i и начинается со слова n - 2 (последняя - со слова n - 1);
+        // ее перенос попадает в еще не записанное слово n + i.
+        const size_t k = n - 2;
+        r[n] = mul_1(r + k, b + k, 2, a[0]);
+        for (size_t i = 1; i <= k; ++i)
+            r[n + i] = addmul_1(r + k, b + k - i, i + 2, a[i]);
+        r[2 * n - 1] = addmul_1(r + n - 1, b, n, a[n - 1]);
+    }
+
+    /**
+     * @brief Величина -m^(-1) mod 2^64 для нечетного m (метод Ньютона: каждая итерация удваивает число верных бит).
+     */
+    inline constexpr u64 neg_inverse_u64(u64 m) noexcept
+    {
+        // Начальное приближение m верно в 3 младших битах (m * m = 1 mod 8).
+        u64 inv = m;
+        for (int i = 0; i < 5; ++i)
+            inv *= 2 - m * inv;
+        return ~inv + 1;
+    }
+
+    /**
+     * @brief Произведение Монтгомери: r = a * b * B^(-n) mod m, операнды и r по n слов.
+     * @details Метод CIOS: умножение на очередное слово b и редукция на одно слово чередуются, поэтому
+     * промежуточная сумма не превышает 2 * m * B^i и целиком помещается в буфере t из 2n + 1 слов.
+     * Требуется нечетный m, minv = -m^(-1) mod 2^64 и a * b < m * B^n (например, a < B^n и b < m);
+     * тогда до вычитания результат меньше 2m. r может совпадать с a или b.
+     */
+    inline constexpr void mont_mul(u64 *r, const u64 *a, const u64 *b, const u64 *m, u64 minv, size_t n, u64 *t) noexcept
+    {
+        std::fill(t, t + 2 * n + 1, 0);
+        for (size_t i = 0; i < n; ++i)
+        {
+            const u64 c1 = addmul_1(t + i, a, n, b[i]);
+            const u64 c2 = addmul_1(t + i, m, n, t[i] * minv);
+            // Слово t[i] обнулилось; переносы обеих строк - в слово i + n.
+            u64 s = t[i + n] + c1;
+            u64 carry = s < c1 ? 1 : 0;
+            s += c2;
+            carry += s < c2 ? 1 : 0;
+            t[i + n] = s;
+            t[i + n + 1] += carry;
+        }
+        if (t[2 * n] != 0 || cmp_n(t + n, m, n) >= 0)
+            sub_n(t + n, t + n, m, n);
+        std::copy_n(t + n, n, r);
+    }
+
+    /**
+     * @brief Деление двухсловного числа на слово: (u1 * 2^64 + u0) / v, требуется u1 < v.
+     */
+    inline constexpr u64 div_2by1(u64 u1, u64 u0, u64 v, u64 *rem) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+        const unsigned __int128 n = (static_cast<unsigned __int128>(u1) << 64) | u0;
+        *rem = static_cast<u64>(n % v);
+        return static_cast<u64>(n / v);
+#else
+#if defined(USE_MSVC_INTRINSICS_DIVISION)
+        if (!std::is_constant_evaluated())
+            return _udiv128(u1, u0, v, rem);
+#endif
+        // Деление по 32-битным "цифрам" (Hacker's Delight, divlu).
+        const int s = std::countl_zero(v);
+        v <<= s;
+        const u64 vn1 = v >> 32, vn0 = v & 0xFFFFFFFFull;
+        const u64 un32 = s == 0 ? u1 : (u1 << s) | (u0 >> (64 - s));
+        const u64 un10 = u0 << s;
+        const u64 un1 = un10 >> 32, un0 = un10 & 0xFFFFFFFFull;
+        u64 q1 = un32 / vn1, rhat = un32 - q1 * vn1;
+        while (q1 >> 32 != 0 || q1 * vn0 > ((rhat << 32) | un1))
+        {
+            --q1;
+            rhat += vn1;
+            if (rhat >> 32 != 0)
+                break;
+        }
+        const u64 un21 = (un32 << 32) + un1 - q1 * v;
+        u64 q0 = un21 / vn1;
+        rhat = un21 - q0 * vn1;
+        while (q0 >> 32 != 0 || q0 * vn0 > ((rhat << 32) | un0))
+        {
+            --q0;
+            rhat += vn1;
+            if (rhat >> 32 != 0)
+                break;
+        }
+        *rem = ((un21 << 32) + un0 - q0 * v) >> s;
+        return (q1 << 32) | q0;
+#endif
+    }
+
+    /**
+     * @brief Делитель-слово с предвычисленной обратной величиной (Мёллер-Гранлунд, 2-by-1).
+     * @details Делитель нормализуется сдвигом влево до установленного старшего бита, обратная величина
+     * v = floor((2^128 - 1) / d) - 2^64 вычисляется один раз аппаратным делением, после чего каждое
+     * деление двухсловного числа стоит одного умножения 64x64 -> 128 и нескольких сложений.
+     */
+    struct DivisorU64
+    {
+        /**
+         * @brief Нормализованный делитель (старший бит установлен).
+         */
+        u64 d;
+
+        /**
+         * @brief Обратная величина нормализованного делителя.
+         */
+        u64 v;
+
+        /**
+         * @brief Величина нормализующего сдвига.
+         */
+        unsigned shift;
+
+        /**
+         * @brief Конструктор.
+         * @param divisor Делитель, не равен нулю.
+         */
+        constexpr explicit DivisorU64(u64 divisor) noexcept
+            : d{divisor << std::countl_zero(divisor)}, v{0}, shift{static_cast<unsigned>(std::countl_zero(divisor))}
+        {
+            u64 rem;
+            v = div_2by1(~d, ~0ull, d, &rem);
+        }
+    };
+
+    /**
+     * @brief Деление двухсловного числа на нормализованный делитель по обратной величине: (u1 * 2^64 + u0) / d,
+     * требуется u1 < d.
+     */
+    inline constexpr u64 div_2by1_preinv(u64 u1, u64 u0, const DivisorU64 &div, u64 *rem) noexcept
+    {
+        const u128::U128 qq = u128::U128::mult_ext(div.v, u1) + u128::U128{u0, u1};
+        u64 q1 = qq.high() + 1;
+        u64 r = u0 - q1 * div.d;
+        // Оценка q1 завышена не более чем на единицу (непредсказуемое условие - без ветвления)
+        // и занижена не более чем на единицу (редкий случай).
+        const u64 mask = u64{0} - static_cast<u64>(r > qq.low());
+        q1 += mask;
+        r += mask & div.d;
+        if (r >= div.d) [[unlikely]]
+        {
+            ++q1;
+            r -= div.d;
+        }
+        *rem = r;
+        return q1;
+    }
+
+    /**
+     * @brief Деление на слово с предвычисленной обратной величиной: q = a / d (n слов, q может совпадать с a).
+     * @details Слова делимого проходятся от старшего к младшему с нормализующим сдвигом "на лету".
+     * @param q Частное, n слов, или nullptr, если нужен только остаток.
+     * @return Остаток.
+     */
+    inline constexpr u64 divrem_u64(u64 *q, const u64 *a, size_t n, const DivisorU64 &div) noexcept
+    {
+        if (n == 0)
+            return 0;
+        const unsigned s = div.shift;
+        u64 hi = a[n - 1];
+        u64 r = s == 0 ? 0 : hi >> (64 - s);
+        for (size_t i = n; i-- > 0;)
+        {
+            const u64 lo = i > 0 ? a[i - 1] : 0;
+            const u64 u0 = s == 0 ? hi : (hi << s) | (lo >> (64 - s));
+            const u64 qi = div_2by1_preinv(r, u0, div, &r);
+            if (q)
+                q[i] = qi;
+            hi = lo;
+        }
+        return r >> s;
+    }
+
+    /**
+     * @brief Деление на слово: q = a / d (n слов, q может совпадать с a или равняться nullptr).
+     * @return Остаток.
+     */
+    inline constexpr u64 divrem_u64(u64 *q, const u64 *a, size_t n, u64 d) noexcept
+    {
+        return divrem_u64(q, a, n, DivisorU64{d});
+    }
+
+    /**
+     * @brief Сдвиг влево на s бит, 0 <= s < 64 (r может совпадать с a).
+     * @return Вытесненные старшие биты.
+     */
+    inline constexpr u64 lshift(u64 *r, const u64 *a, size_t n, unsigned s) noexcept
+    {
+        if (s == 0)
+        {
+            for (size_t i = n; i-- > 0;)
+                r[i] = a[i];
+            return 0;
+        }
+        const u64 out = a[n - 1] >> (64 - s);
+        for (size_t i = n - 1; i > 0; --i)
+            r[i] = (a[i] << s) | (a[i - 1] >> (64 - s));
+        r[0] = a[0] << s;
+        return out;
+    }
+
+    /**
+     * @brief Сдвиг вправо на s бит, 0 <= s < 64 (r может совпадать с a).
+     * @return Вытесненные младшие биты (в старших разрядах слова).
+     */
+    inline constexpr u64 rshift(u64 *r, const u64 *a, size_t n, unsigned s) noexcept
+    {
+        if (s == 0)
+        {
+            for (size_t i = 0; i < n; ++i)
+                r[i] = a[i];
+            return 0;
+        }
+        const u64 out = a[0] << (64 - s);
+        for (size_t i = 0; i + 1 < n; ++i)
+            r[i] = (a[i] >> s) | (a[i + 1] << (64 - s));
+        r[n - 1] = a[n - 1] >> s;
+        return out;
+    }
+
+    /**
+     * @brief Возведение в квадрат "в столбик": r = a^2, r из 2n слов и не пересекается с a.
+     * @details Недиагональные произведения a[i] * a[j], i < j, вычисляются по одному разу, их сумма удваивается сдвигом,
+     * затем прибавляются квадраты a[i]^2: около n^2 / 2 умножений слов вместо n^2.
+     */
+    inline constexpr void sqr_basecase(u64 *r, const u64 *a, size_t n) noexcept
+    {
+        r[0] = 0;
+        r[2 * n - 1] = 0;
+        if (n > 1)
+            r[n] = mul_1(r + 1, a + 1, n - 1, a[0]);
+        for (size_t i = 1; i + 1 < n; ++i)
+            r[n + i] = addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+        // Удвоение и прибавление диагонали за один проход: слова r[2i], r[2i + 1] сдвигаются на бит влево
+        // (top - вытесненный бит предыдущего слова), к ним прибавляется a[i]^2.
+        u64 top = 0;
+#if defined(USE_X86_CARRY_INTRINSICS)
+        if (!std::is_constant_evaluated())
+        {
+            unsigned char c = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                const u128::U128 p = u128::U128::mult_ext(a[i], a[i]);
+                const u64 lo = (r[2 * i] << 1) | top;
+                const u64 hi = (r[2 * i + 1] << 1) | (r[2 * i] >> 63);
+                top = r[2 * i + 1] >> 63;
+                unsigned long long t;
+                c = _addcarry_u64(c, lo, p.low(), &t);
+                r[2 * i] = t;
+                c = _addcarry_u64(c, hi, p.high(), &t);
+                r[2 * i + 1] = t;
+            }
+            return;
+        }
+#endif
+        u64 carry = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const u128::U128 p = u128::U128::mult_ext(a[i], a[i]);
+            const u64 lo = (r[2 * i] << 1) | top;
+            const u64 hi = (r[2 * i + 1] << 1) | (r[2 * i] >> 63);
+            top = r[2 * i + 1] >> 63;
+            const u128::U128 x{lo, hi};
+            u128::U128 sum = x + p;
+            const u64 c1 = sum < x ? 1 : 0;
+            sum += u128::U128{carry};
+            carry = c1 + (sum < u128::U128{carry} ? 1 : 0);
+            r[2 * i] = sum.low();
+            r[2 * i + 1] = sum.high();
+        }
+    }
+
+    /**
+     * @brief Деление с остатком (алгоритм D Кнута): q = a / b, r = a mod b.
+     * @param q Частное, na - nb + 1 слов, или nullptr, если частное не нужно.
+     * @param r Остаток, nb слов, или nullptr, если остаток не нужен (он не восстанавливается обратным сдвигом).
+     * @param b Делитель, старшее слово b[nb - 1] не равно нулю, na >= nb.
+     * @param work Рабочий буфер на na + nb + 1 слов.
+     * @details Оценка очередной цифры частного по двум старшим словам нормализованного делителя
+     * ошибается не более чем на 2, после проверки по третьему слову - не более чем на 1,
+     * поэтому коррекция на каждом шаге ограничена одним сложением.
+     */
+    inline constexpr void divrem(u64 *q, u64 *r, const u64 *a, size_t na, const u64 *b, size_t nb, u64 *work) noexcept
+    {
+        if (nb == 1)
+        {
+            const u64 rem = divrem_u64(q, a, na, b[0]);
+            if (r)
+                r[0] = rem;
+            return;
+        }
+        u64 *u = work;          // na + 1 слов
+        u64 *v = work + na + 1; // nb слов
+        const unsigned s = static_cast<unsigned>(std::countl_zero(b[nb - 1]));
+        lshift(v, b, nb, s);
+        u[na] = lshift(u, a, na, s);
+        const u64 v1 = v[nb - 1], v2 = v[nb - 2];
+        const DivisorU64 v1_inv{v1};
+        for (size_t j = na - nb + 1; j-- > 0;)
+        {
+            const u64 u2 = u[j + nb], u1 = u[j + nb - 1], u0 = u[j + nb - 2];
+            u64 qhat, rhat;
+            bool rhat_overflow = false;
+            if (u2 >= v1)
+            {
+                // Оценка не помещается в слово: берем максимум.
+                qhat = ~0ull;
+                rhat = u1 + v1;
+                rhat_overflow = rhat < u1;
+            }
+            else
+            {
+                qhat = div_2by1_preinv(u2, u1, v1_inv, &rhat);
+            }
+            while (!rhat_overflow)
+            {
+                const u128::U128 lhs = u128::U128::mult_ext(qhat, v2);
+                if (lhs <= u128::U128{u0, rhat})
+                    break;
+                --qhat;
+                rhat += v1;
+                rhat_overflow = rhat < v1;
+            }
+            const u64 borrow = submul_1(u + j, v, nb, qhat);
+            const u64 top = u[j + nb];
+            u[j + nb] = top - borrow;
+            if (top < borrow)
+            {
+                --qhat;
+                u[j + nb] += add_n(u + j, u + j, v, nb);
+            }
+            if (q)
+                q[j] = qhat;
+        }
+        if (r)
+            rshift(r, u, nb, s);
+    }
+
+    /**
+     * @brief r += a (r из rn слов, a из an <= rn слов) с распространением переноса.
+     * @return Перенос из старшего слова r.
+     */
+    inline constexpr u64 add_into(u64 *r, size_t rn, const u64 *a, size_t an) noexcept
+    {
+        u64 carry = add_n(r, r, a, an);
+        for (size_t i = an; carry != 0 && i < rn; ++i)
+            carry = ++r[i] == 0 ? 1 : 0;
+        return carry;
+    }
+
+    /**
+     * @brief r -= a (r из rn слов, a из an <= rn слов) с распространением заема.
+     * @return Заем из старшего слова r.
+     */
+    inline constexpr u64 sub_from(u64 *r, size_t rn, const u64 *a, size_t an) noexcept
+    {
+        u64 borrow = sub_n(r, r, a, an);
+        for (size_t i = an; borrow != 0 && i < rn; ++i)
+            borrow = r[i]-- == 0 ? 1 : 0;
+        return borrow;
+    }
+
+    /**
+     * @brief r = |a - b|, где a из an слов, b из bn <= an слов, r из an слов.
+     * @return true, если a < b.
+     */
+    inline constexpr bool abs_diff(u64 *r, const u64 *a, size_t an, const u64 *b, size_t bn) noexcept
+    {
+        const bool less = normalized_size(a + bn, an - bn) == 0 && cmp_n(a, b, bn) < 0;
+        if (less)
+        {
+            sub_n(r, b, a, bn);
+            std::fill(r + bn, r + an, 0);
+        }
+        else
+        {
+            std::copy_n(a, an, r);
+            sub_from(r, an, b, bn);
+        }
+        return less;
+    }
+
+    /**
+     * @brief Длина операндов (в словах), начиная с которой mul_n использует метод Карацубы.
+     */
+    inline constexpr size_t MUL_KARATSUBA_THRESHOLD = 20;
+
+#if defined(USE_X86_ADX_KERNELS)
+    /**
+     * @brief Порог метода Карацубы при школьном умножении на ядре MULX/ADCX/ADOX (оно почти вдвое быстрее).
+     */
+    inline constexpr size_t MUL_KARATSUBA_THRESHOLD_ADX = 48;
+#endif
+
+    /**
+     * @brief Порог метода Карацубы для текущего процессора.
+     */
+    inline size_t karatsuba_threshold() noexcept
+    {
+#if defined(USE_X86_ADX_KERNELS)
+        if (CPU_HAS_ADX)
+            return MUL_KARATSUBA_THRESHOLD_ADX;
+#endif
+        return MUL_KARATSUBA_THRESHOLD;
+    }
+
+    /**
+     * @brief Длина операндов (в словах), начиная с которой mul_n использует метод Тоома-Кука (Toom-3).
+     */
+    inline constexpr size_t MUL_TOOM3_THRESHOLD = 192;
+
+    /**
+     * @brief Длина (в словах), начиная с которой sqr_n использует метод Карацубы: школьный квадрат почти вдвое
+     * дешевле школьного умножения, поэтому порог выше, чем у mul_n.
+     */
+    inline constexpr size_t SQR_KARATSUBA_THRESHOLD = 40;
+
+#if defined(USE_X86_ADX_KERNELS)
+    /**
+     * @brief Порог метода Карацубы для квадрата при строках addmul_1 на ядре MULX/ADCX/ADOX.
+     */
+    inline constexpr size_t SQR_KARATSUBA_THRESHOLD_ADX = 96;
+#endif
+
+    static_assert(SQR_KARATSUBA_THRESHOLD >= MUL_KARATSUBA_THRESHOLD);
+
+    /**
+     * @brief Порог метода Карацубы для квадрата на текущем процессоре.
+     */
+    inline size_t sqr_karatsuba_threshold() noexcept
+    {
+#if defined(USE_X86_ADX_KERNELS)
+        if (CPU_HAS_ADX)
+            return SQR_KARATSUBA_THRESHOLD_ADX;
+#endif
+        return SQR_KARATSUBA_THRESHOLD;
+    }
+
+    /**
+     * @brief Размер рабочего буфера (в словах) для mul_n и sqr_n с операндами по n слов.
+     * @details Каждый уровень рекурсии берет свою часть буфера и передает остаток вниз; оценка сверху не зависит
+     * от процессора (считается по наименьшему порогу MUL_KARATSUBA_THRESHOLD), поэтому годится для std::array.
+     */
+    inline constexpr size_t mul_scratch_size(size_t n) noexcept;
+
+    /**
+     * @brief Рабочий буфер mul_karatsuba / sqr_karatsuba: свои 6l + 1 слов и буфер для половин.
+     */
+    inline constexpr size_t karatsuba_scratch_size(size_t n) noexcept
+    {
+        const size_t l = (n + 1) / 2;
+        return 6 * l + 1 + mul_scratch_size(l);
+    }
+
+    /**
+     * @brief Рабочий буфер mul_toom3: значения в трех точках, четыре произведения по 2m слов и буфер для частей.
+     */
+    inline constexpr size_t toom3_scratch_size(size_t n) noexcept
+    {
+        const size_t m = (n + 2) / 3 + 1;
+        return 14 * m + mul_scratch_size(m);
+    }
+
+    inline constexpr size_t mul_scratch_size(size_t n) noexcept
+    {
+        if (n < MUL_KARATSUBA_THRESHOLD)
+            return 0;
+        if (n < MUL_TOOM3_THRESHOLD)
+            return karatsuba_scratch_size(n);
+        return toom3_scratch_size(n);
+    }
+
+    inline void mul_n(u64 *r, const u64 *a, const u64 *b, size_t n, u64 *t);
+
+    inline void sqr_n(u64 *r, const u64 *a, size_t n, u64 *t);
+
+    /**
+     * @brief Умножение методом Карацубы: r = a * b, операнды по n слов, r из 2n слов.
+     * @details a = a1 * B^l + a0, b = b1 * B^l + b0, средний коэффициент a0 * b1 + a1 * b0 = z0 + z2 - (a1 - a0)(b1 - b0)
+     * вычисляется через модули разностей, поэтому все три произведения имеют длину не более l слов.
+     * @param t Рабочий буфер из mul_scratch_size(n) слов.
+     */
+    inline void mul_karatsuba(u64 *r, const u64 *a, const u64 *b, size_t n, u64 *t)
+    {
+        const size_t l = (n + 1) / 2;
+        const size_t h = n - l;
+        u64 *const dx = t;
+        u64 *const dy = dx + l;
+        u64 *const d = dy + l;
+        u64 *const mid = d + 2 * l;
+        u64 *const next = mid + 2 * l + 1;
+        const bool x_neg = abs_diff(dx, a, l, a + l, h);
+        const bool y_neg = abs_diff(dy, b, l, b + l, h);
+        mul_n(r, a, b, l, next);
+        mul_n(r + 2 * l, a + l, b + l, h, next);
+        mul_n(d, dx, dy, l, next);
+        // mid = z0 + z2 -+ d, не более 2l + 1 слов.
+        std::copy_n(r, 2 * l, mid);
+        mid[2 * l] = 0;
+        add_into(mid, 2 * l + 1, r + 2 * l, 2 * h);
+        if (x_neg == y_neg)
+            sub_from(mid, 2 * l + 1, d, 2 * l);
+        else
+            add_into(mid, 2 * l + 1, d, 2 * l);
+        add_into(r + l, 2 * n - l, mid, std::min(2 * l + 1, 2 * n - l));
+    }
+
+    inline void mul_karatsuba(u64 *r, const u64 *a, const u64 *b, size_t n)
+    {
+        std::vector<u64> t(karatsuba_scratch_size(n));
+        mul_karatsuba(r, a, b, n, t.data());
+    }
+
+    /**
+     * @brief Возведение в квадрат методом Карацубы: r = a^2, a из n слов, r из 2n слов.
+     * @details 2 * a0 * a1 = z0 + z2 - (a1 - a0)^2: три квадрата длины не более l слов, знак разности не нужен.
+     * @param t Рабочий буфер из mul_scratch_size(n) слов.
+     */
+    inline void sqr_karatsuba(u64 *r, const u64 *a, size_t n, u64 *t)
+    {
+        const size_t l = (n + 1) / 2;
+        const size_t h = n - l;
+        u64 *const dx = t;
+        u64 *const d = dx + l;
+        u64 *const mid = d + 2 * l;
+        u64 *const next = mid + 2 * l + 1;
+        abs_diff(dx, a, l, a + l, h);
+        sqr_n(r, a, l, next);
+        sqr_n(r + 2 * l, a + l, h, next);
+        sqr_n(d, dx, l, next);
+        std::copy_n(r, 2 * l, mid);
+        mid[2 * l] = 0;
+        add_into(mid, 2 * l + 1, r + 2 * l, 2 * h);
+        sub_from(mid, 2 * l + 1, d, 2 * l);
+        add_into(r + l, 2 * n - l, mid, std::min(2 * l + 1, 2 * n - l));
+    }
+
+    /**
+     * @brief Вычисление значений a(1), |a(-1)| и a(2) многочлена a2 * x^2 + a1 * x + a0 (части по k и k2 слов).
+     * @return true, если a(-1) < 0.
+     */
+    inline constexpr bool toom3_evaluate(u64 *e1, u64 *em1, u64 *e2, const u64 *a, size_t k, size_t k2) noexcept
+    {
+        const size_t m = k + 1;
+        const u64 *const a1 = a + k;
+        const u64 *const a2 = a + 2 * k;
+        std::copy_n(a, k, e1);
+        e1[k] = 0;
+        add_into(e1, m, a2, k2);
+        const bool neg = abs_diff(em1, e1, m, a1, k);
+        add_into(e1, m, a1, k);
+        // a(2) = ((a2 * 2 + a1) * 2) + a0 < 7 * B^k.
+        std::copy_n(a2, k2, e2);
+        std::fill(e2 + k2, e2 + m, 0);
+        lshift(e2, e2, m, 1);
+        add_into(e2, m, a1, k);
+        lshift(e2, e2, m, 1);
+        add_into(e2, m, a, k);
+        return neg;
+    }
+
+    /**
+     * @brief Умножение методом Тоома-Кука (Toom-3): r = a * b, операнды по n >= 5 слов, r из 2n слов.
+     * @details Операнды делятся на три части по k = ceil(n / 3) слов, произведение многочленов восстанавливается
+     * по значениям в точках 0, 1, -1, 2 и бесконечности: пять произведений длины около n / 3 вместо девяти.
+     * Коэффициенты произведения неотрицательны, и интерполяция построена так, что все промежуточные величины
+     * также неотрицательны: c2 = (r(1) + r(-1)) / 2 - c0 - c4, c3 = (r(2) - c0 - 4c2 - 16c4 - (r(1) - r(-1))) / 6,
+     * c1 = (r(1) - r(-1)) / 2 - c3.
+     * При a == b значения считаются один раз, и все пять произведений - квадраты (sqr_n через mul_n).
+     * @param t Рабочий буфер из mul_scratch_size(n) слов.
+     */
+    inline void mul_toom3(u64 *r, const u64 *a, const u64 *b, size_t n, u64 *t)
+    {
+        const size_t k = (n + 2) / 3;
+        const size_t k2 = n - 2 * k;
+        const size_t m = k + 1;
+        const size_t len = 2 * m;
+        u64 *const ea1 = t;
+        u64 *const eam1 = ea1 + m;
+        u64 *const ea2 = eam1 + m;
+        u64 *eb1 = ea2 + m;
+        u64 *ebm1 = eb1 + m;
+        u64 *eb2 = ebm1 + m;
+        u64 *const p1 = ea2 + 4 * m;
+        u64 *const pm1 = p1 + len;
+        u64 *const p2 = pm1 + len;
+        u64 *const odd = p2 + len;
+        u64 *const next = odd + len;
+        bool neg = toom3_evaluate(ea1, eam1, ea2, a, k, k2);
+        if (a == b)
+        {
+            eb1 = ea1;
+            ebm1 = eam1;
+            eb2 = ea2;
+            neg = false;
+        }
+        else
+            neg = neg != toom3_evaluate(eb1, ebm1, eb2, b, k, k2);
+        u64 *const c0 = r;
+        u64 *const c4 = r + 4 * k;
+        mul_n(c0, a, b, k, next);
+        mul_n(c4, a + 2 * k, b + 2 * k, k2, next);
+        mul_n(p1, ea1, eb1, m, next);
+        mul_n(pm1, eam1, ebm1, m, next);
+        mul_n(p2, ea2, eb2, m, next);
+        std::fill(r + 2 * k, r + 4 * k, 0);
+        // odd = c1 + c3 = (r(1) - r(-1)) / 2, p1 = c0 + c2 + c4 = (r(1) + r(-1)) / 2.
+        if (neg)
+        {
+            add_n(odd, p1, pm1, len);
+            sub_n(p1, p1, pm1, len);
+        }
+        else
+        {
+            sub_n(odd, p1, pm1, len);
+            add_n(p1, p1, pm1, len);
+        }
+        rshift(odd, odd, len, 1);
+        rshift(p1, p1, len, 1);
+        // p1 = c2.
+        sub_from(p1, len, c0, 2 * k);
+        sub_from(p1, len, c4, 2 * k2);
+        // p2 = c3 = (r(2) - c0 - 4c2 - 16c4 - 2 * odd) / 6, pm1 - временный буфер.
+        sub_from(p2, len, c0, 2 * k);
+        lshift(pm1, p1, len, 2);
+        sub_n(p2, p2, pm1, len);
+        std::copy_n(c4, 2 * k2, pm1);
+        std::fill(pm1 + 2 * k2, pm1 + len, 0);
+        lshift(pm1, pm1, len, 4);
+        sub_n(p2, p2, pm1, len);
+        lshift(pm1, odd, len, 1);
+        sub_n(p2, p2, pm1, len);
+        rshift(p2, p2, len, 1);
+        divrem_u64(p2, p2, len, 3);
+        // odd = c1.
+        sub_n(odd, odd, p2, len);
+        add_into(r + k, 2 * n - k, odd, std::min(len, 2 * n - k));
+        add_into(r + 2 * k, 2 * n - 2 * k, p1, std::min(len, 2 * n - 2 * k));
+        add_into(r + 3 * k, 2 * n - 3 * k, p2, std::min(len, 2 * n - 3 * k));
+    }
+
+    inline void mul_toom3(u64 *r, const u64 *a, const u64 *b, size_t n)
+    {
+        std::vector<u64> t(toom3_scratch_size(n));
+        mul_toom3(r, a, b, n, t.data());
+    }
+
+    /**
+     * @brief Умножение чисел одинаковой длины: r = a * b, r из 2n слов и не пересекается с a и b.
+     * @details Школьный метод, метод Карацубы или Toom-3 в зависимости от длины (пороги karatsuba_threshold()
+     * и MUL_TOOM3_THRESHOLD); рекурсивные произведения снова выбирают метод по своей длине.
+     * Квадрат (a == b) считается через sqr_n.
+     * @param t Рабочий буфер из mul_scratch_size(n) слов, общий для всей рекурсии.
+     */
+    inline void mul_n(u64 *r, const u64 *a, const u64 *b, size_t n, u64 *t)
+    {
+        if (a == b)
+            sqr_n(r, a, n, t);
+        else if (n < karatsuba_threshold())
+            mul_basecase(r, a, n, b, n);
+        else if (n < MUL_TOOM3_THRESHOLD)
+            mul_karatsuba(r, a, b, n, t);
+        else
+            mul_toom3(r, a, b, n, t);
+    }
+
+    /**
+     * @brief Умножение чисел одинаковой длины с рабочим буфером в куче (выделяется один раз на все уровни рекурсии).
+     */
+    inline void mul_n(u64 *r, const u64 *a, const u64 *b, size_t n)
+    {
+        if (a == b ? n < sqr_karatsuba_threshold() : n < karatsuba_threshold())
+        {
+            mul_n(r, a, b, n, nullptr);
+            return;
+        }
+        std::vector<u64> t(mul_scratch_size(n));
+        mul_n(r, a, b, n, t.data());
+    }
+
+    /**
+     * @brief Возведение в квадрат: r = a^2, r из 2n слов и не пересекается с a.
+     * @details Школьный квадрат, Карацуба (порог sqr_karatsuba_threshold()) или Toom-3 с общими значениями.
+     * @param t Рабочий буфер из mul_scratch_size(n) слов.
+     */
+    inline void sqr_n(u64 *r, const u64 *a, size_t n, u64 *t)
+    {
+        if (n < sqr_karatsuba_threshold())
+            sqr_basecase(r, a, n);
+        else if (n < MUL_TOOM3_THRESHOLD)
+            sqr_karatsuba(r, a, n, t);
+        else
+            mul_toom3(r, a, a, n, t);
+    }
+
+    inline void sqr_n(u64 *r, const u64 *a, size_t n)
+    {
+        mul_n(r, a, a, n);
+    }
+
+    /**
+     * @brief Умножение чисел разной длины: r = a * b, na >= nb, r из na + nb слов и не пересекается с a и b.
+     * @details Длинный операнд режется на куски по nb слов, каждый кусок умножается через mul_n.
+     */
+    inline void mul(u64 *r, const u64 *a, size_t na, const u64 *b, size_t nb)
+    {
+        if (nb < karatsuba_threshold())
+        {
+            mul_basecase(r, a, na, b, nb);
+            return;
+        }
+        if (na == nb)
+        {
+            mul_n(r, a, b, na);
+            return;
+        }
+        std::fill(r, r + na + nb, 0);
+        std::vector<u64> t(2 * nb + mul_scratch_size(nb));
+        for (size_t i = 0; i < na; i += nb)
+        {
+            const size_t len = std::min(nb, na - i);
+            if (len == nb)
+                mul_n(t.data(), a + i, b, nb, t.data() + 2 * nb);
+            else
+                mul(t.data(), b, nb, a + i, len);
+            add_into(r + i, na + nb - i, t.data(), len + nb);
+        }
+    }
+
+    /**
+     * @brief Длина делителя (в словах), ниже которой шаг divrem_bz выполняется алгоритмом D.
+     * divrem_auto выбирает Буркеля-Циглера для делителей от 2 * DIV_BZ_THRESHOLD слов.
+     */
+    inline constexpr size_t DIV_BZ_THRESHOLD = 80;
+
+    void div_2n_1n(u64 *q, u64 *r, const u64 *a, const u64 *b, size_t n);
+
+    /**
+     * @brief Шаг Буркеля-Циглера 3h / 2h: q = a / b, r = a mod b, где a из 3h слов, b из 2h слов (нормализован),
+     * a < b * B^h; q из h слов, r из 2h слов.
+     * @details Частное оценивается делением старших 2h слов a на старшую половину b (рекурсия в div_2n_1n),
+     * после вычитания q * b0 оценка превышает истинное частное не более чем на 2.
+     */
+    inline void div_3h_2h(u64 *q, u64 *r, const u64 *a, const u64 *b, size_t h)
+    {
+        const u64 *const b0 = b;
+        const u64 *const b1 = b + h;
+        std::vector<u64> t(4 * h + 1);
+        u64 *const rh = t.data(); // 2h + 1 слов
+        u64 *const d = rh + 2 * h + 1;
+        std::copy_n(a, h, rh);
+        if (cmp_n(a + 2 * h, b1, h) < 0)
+        {
+            div_2n_1n(q, rh + h, a + h, b1, h);
+            rh[2 * h] = 0;
+        }
+        else
+        {
+            // Старшая половина a равна b1: q = B^h - 1, остаток a1 + b1.
+            std::fill(q, q + h, ~0ull);
+            std::copy_n(a + h, h, rh + h);
+            rh[2 * h] = add_n(rh + h, rh + h, b1, h);
+        }
+        mul_n(d, q, b0, h);
+        u64 borrow = sub_from(rh, 2 * h + 1, d, 2 * h);
+        while (borrow != 0)
+        {
+            borrow -= add_into(rh, 2 * h + 1, b, 2 * h);
+            for (size_t i = 0; q[i]-- == 0; ++i)
+            {
+            }
+        }
+        std::copy_n(rh, 2 * h, r);
+    }
+
+    /**
+     * @brief Шаг Буркеля-Циглера 2n / n: q = a / b, r = a mod b, где a из 2n слов, b из n слов (нормализован),
+     * a < b * B^n; q и r по n слов.
+     * @details При нечетном n или n < DIV_BZ_THRESHOLD - алгоритм D, иначе два шага 3h / 2h, h = n / 2.
+     */
+    inline void div_2n_1n(u64 *q, u64 *r, const u64 *a, const u64 *b, size_t n)
+    {
+        if (n % 2 != 0 || n < DIV_BZ_THRESHOLD)
+        {
+            std::vector<u64> t(n + 1 + 3 * n + 1);
+            divrem(t.data(), r, a, 2 * n, b, n, t.data() + n + 1);
+            std::copy_n(t.data(), n, q);
+            return;
+        }
+        const size_t h = n / 2;
+        std::vector<u64> t(3 * h + 2 * h);
+        u64 *const a_next = t.data();
+        u64 *const r1 = a_next + 3 * h;
+        div_3h_2h(q + h, r1, a + h, b, h);
+        std::copy_n(a, h, a_next);
+        std::copy_n(r1, 2 * h, a_next + h);
+        div_3h_2h(q, r, a_next, b, h);
+    }
+
+    /**
+     * @brief Деление с остатком методом Буркеля-Циглера: q = a / b, r = a mod b.
+     * @param q Частное, na - nb + 1 слов, или nullptr.
+     * @param r Остаток, nb слов, или nullptr.
+     * @param b Делитель, старшее слово b[nb - 1] не равно нулю, na >= nb.
+     * @details Делитель дополняется младшими нулевыми словами до длины n = j * 2^k (j не больше порога)
+     * и нормализуется сдвигом; делимое режется на блоки по n слов, которые делятся по схеме 2n / n от старших к младшим.
+     * Внутри рекурсии деление сводится к произведениям половинной длины (mul_n: Карацуба, Toom-3),
+     * а коррекция на каждом шаге ограничена двумя сложениями.
+     */
+    inline void divrem_bz(u64 *q, u64 *r, const u64 *a, size_t na, const u64 *b, size_t nb)
+    {
+        const size_t m = std::bit_ceil(nb / DIV_BZ_THRESHOLD + 1);
+        const size_t n = (nb + m - 1) / m * m;
+        const size_t sigma = n - nb;
+        const unsigned s = static_cast<unsigned>(std::countl_zero(b[nb - 1]));
+        std::vector<u64> bn(n);
+        lshift(bn.data() + sigma, b, nb, s);
+        // Делимое со сдвигом и хотя бы одним свободным старшим битом: старший блок меньше делителя.
+        const size_t t = std::max<size_t>(2, (na + sigma + n) / n);
+        std::vector<u64> an(t * n);
+        an[na + sigma] = lshift(an.data() + sigma, a, na, s);
+        std::vector<u64> qn((t - 1) * n), z(2 * n), rn(n);
+        std::copy_n(an.data() + (t - 2) * n, 2 * n, z.data());
+        for (size_t i = t - 1; i-- > 0;)
+        {
+            div_2n_1n(qn.data() + i * n, rn.data(), z.data(), bn.data(), n);
+            if (i > 0)
+            {
+                std::copy_n(an.data() + (i - 1) * n, n, z.data());
+                std::copy_n(rn.data(), n, z.data() + n);
+            }
+        }
+        if (q)
+            std::copy_n(qn.data(), na - nb + 1, q);
+        if (r)
+            rshift(r, rn.data() + sigma, nb, s);
+    }
+
+    /**
+     * @brief Деление с остатком с выбором метода по длине делителя: алгоритм D или Буркель-Циглер.
+     * @param q Частное, na - nb + 1 слов, или nullptr.
+     * @param r Остаток, nb слов, или nullptr.
+     * @param b Делитель, старшее слово b[nb - 1] не равно нулю, na >= nb.
+     */
+    inline void divrem_auto(u64 *q, u64 *r, const u64 *a, size_t na, const u64 *b, size_t nb)
+    {
+        if (nb >= 2 * DIV_BZ_THRESHOLD && na - nb >= DIV_BZ_THRESHOLD)
+        {
+            divrem_bz(q, r, a, na, b, nb);
+            return;
+        }
+        std::vector<u64> work(na + nb + 1);
+        divrem(q, r, a, na, b, nb, work.data());
+    }
+
+    /**
+     * @brief Порог (в десятичных цифрах), ниже которого перевод в строку идет простым циклом деления на 10^19.
+     */
+    inline constexpr size_t TO_DECIMAL_DC_THRESHOLD_DIGITS = 300;
+
+    /**
+     * @brief Порог (в десятичных цифрах), ниже которого разбор строки идет блоками по 19 цифр с умножением на слово.
+     */
+    inline constexpr size_t FROM_DECIMAL_DC_THRESHOLD_DIGITS = 400;
+
+    /**
+     * @brief Количество слов, достаточное для числа из ndigits десятичных цифр (log2(10) < 3.322).
+     */
+    inline constexpr size_t limbs_for_digits(size_t ndigits) noexcept
+    {
+        return ndigits * 3322 / 1000 / 64 + 1;
+    }
+
+    /**
+     * @brief Таблица степеней 10^(18 * 2^k), k = 0, 1, ... для десятичных преобразований "разделяй и властвуй".
+     */
+    class Pow10Table
+    {
+        std::vector<std::vector<u64>> mPowers;
+
+    public:
+        /**
+         * @brief Строит степени, необходимые для чисел не длиннее max_digits десятичных цифр.
+         */
+        explicit Pow10Table(size_t max_digits)
+        {
+            mPowers.push_back({bignum::detail::POW10[18]});
+            while (digits(mPowers.size()) < max_digits)
+            {
+                const auto &p = mPowers.back();
+                std::vector<u64> sq(2 * p.size());
+                mul_n(sq.data(), p.data(), p.data(), p.size());
+                sq.resize(normalized_size(sq.data(), sq.size()));
+                mPowers.push_back(std::move(sq));
+            }
+        }
+
+        /**
+         * @brief Количество степеней в таблице.
+         */
+        [[nodiscard]] size_t size() const noexcept { return mPowers.size(); }
+
+        /**
+         * @brief Степень 10^(18 * 2^k) в виде нормализованного массива слов.
+         */
+        [[nodiscard]] const std::vector<u64> &operator[](size_t k) const noexcept { return mPowers[k]; }
+
+        /**
+         * @brief Показатель степени десяти k-го элемента таблицы: 18 * 2^k.
+         */
+        static constexpr size_t digits(size_t k) noexcept { return size_t{18} << k; }
+    };
+
+    /**
+     * @brief Запись ровно ndigits младших десятичных цифр числа справа налево до end: простой цикл деления на 10^19.
+     */
+    inline void to_decimal_basecase(const u64 *a, size_t n, char *end, size_t ndigits)
+    {
+        static constexpr DivisorU64 POW10_19{bignum::detail::POW10[19]};
+        std::vector<u64> t(a, a + n);
+        n = normalized_size(t.data(), n);
+        while (ndigits > 0)
+        {
+            const size_t len = std::min<size_t>(ndigits, bignum::detail::DECIMAL_BLOCK_DIGITS);
+            u64 rem = 0;
+            if (n > 0)
+            {
+                rem = divrem_u64(t.data(), t.data(), n, POW10_19);
+                n = normalized_size(t.data(), n);
+            }
+            bignum::detail::write_digits(end, rem, static_cast<int>(len));
+            end -= len;
+            ndigits -= len;
+        }
+    }
+
+    /**
+     * @brief Запись ровно ndigits десятичных цифр числа a (a < 10^ndigits) справа налево до end, с ведущими нулями.
+     * @details Число делится на степень 10^(18 * 2^k) из таблицы, ближайшую снизу к ndigits, и обе части
+     * переводятся рекурсивно. Ниже порога TO_DECIMAL_DC_THRESHOLD_DIGITS работает простой цикл.
+     */
+    inline void to_decimal(const u64 *a, size_t n, char *end, size_t ndigits, const Pow10Table &table)
+    {
+        n = normalized_size(a, n);
+        if (n == 0)
+        {
+            std::fill(end - ndigits, end, '0');
+            return;
+        }
+        size_t k = table.size();
+        while (k > 0 && Pow10Table::digits(k - 1) >= ndigits)
+            --k;
+        if (k == 0 || ndigits <= TO_DECIMAL_DC_THRESHOLD_DIGITS)
+        {
+            to_decimal_basecase(a, n, end, ndigits);
+            return;
+        }
+        --k;
+        const size_t low_digits = Pow10Table::digits(k);
+        const std::vector<u64> &p = table[k];
+        const size_t m = p.size();
+        if (n < m || (n == m && cmp_n(a, p.data(), m) < 0))
+        {
+            // Старшая часть нулевая.
+            to_decimal(a, n, end, low_digits, table);
+            std::fill(end - ndigits, end - low_digits, '0');
+            return;
+        }
+        std::vector<u64> q(n - m + 1), r(m), work(n + m + 1);
+        divrem(q.data(), r.data(), a, n, p.data(), m, work.data());
+        to_decimal(r.data(), m, end, low_digits, table);
+        to_decimal(q.data(), q.size(), end - low_digits, ndigits - low_digits, table);
+    }
+
+    /**
+     * @brief Разбор ndigits десятичных цифр (без проверки) в число r из rn слов: блоки по 19 цифр слева направо.
+     */
+    inline void from_decimal_basecase(const char *s, size_t ndigits, u64 *r, size_t rn)
+    {
+        std::fill(r, r + rn, 0);
+        size_t n = 0;
+        const char *const end = s + ndigits;
+        size_t len = ndigits % bignum::detail::DECIMAL_BLOCK_DIGITS;
+        if (len == 0)
+            len = bignum::detail::DECIMAL_BLOCK_DIGITS;
+        for (const char *p = s; p != end; p += len, len = bignum::detail::DECIMAL_BLOCK_DIGITS)
+        {
+            u64 block;
+            bignum::detail::parse_decimal_block(p, p + len, block);
+            const u64 carry = mul_add_1(r, n, bignum::detail::POW10[len], block);
+            if (carry != 0 && n < rn)
+                r[n++] = carry;
+        }
+    }
+
+    /**
+     * @brief Разбор ndigits десятичных цифр (без проверки) в число r из rn >= limbs_for_digits(ndigits) слов.
+     * @details Строка делится на старшую часть и младшие 18 * 2^k цифр, части разбираются рекурсивно
+     * и объединяются как hi * 10^(18 * 2^k) + lo. Ниже порога FROM_DECIMAL_DC_THRESHOLD_DIGITS - блоками по 19 цифр.
+     */
+    inline void from_decimal(const char *s, size_t ndigits, u64 *r, size_t rn, const Pow10Table &table)
+    {
+        size_t k = table.size();
+        while (k > 0 && Pow10Table::digits(k - 1) >= ndigits)
+            --k;
+        if (k == 0 || ndigits <= FROM_DECIMAL_DC_THRESHOLD_DIGITS)
+        {
+            from_decimal_basecase(s, ndigits, r, rn);
+            return;
+        }
+        --k;
+        const size_t low_digits = Pow10Table::digits(k);
+        const size_t high_digits = ndigits - low_digits;
+        const std::vector<u64> &p = table[k];
+        std::vector<u64> hi(limbs_for_digits(high_digits));
+        from_decimal(s, high_digits, hi.data(), hi.size(), table);
+        std::fill(r, r + rn, 0);
+        if (const size_t hn = normalized_size(hi.data(), hi.size()); hn > 0)
+        {
+            std::vector<u64> prod(hn + p.size());
+            if (hn >= p.size())
+                mul(prod.data(), hi.data(), hn, p.data(), p.size());
+            else
+                mul(prod.data(), p.data(), p.size(), hi.data(), hn);
+            std::copy_n(prod.data(), std::min(prod.size(), rn), r);
+        }
+        std::vector<u64> lo(limbs_for_digits(low_digits));
+        from_decimal(s + high_digits, low_digits, lo.data(), lo.size(), table);
+        add_into(r, rn, lo.data(), std::min(lo.size(), rn));
+    }
+
+    /**
+     * @brief Таблица степеней для чисел не длиннее MaxDigits десятичных цифр, своя для каждой разрядности.
+     * Строится один раз при первом обращении.
+     */
+    template <size_t MaxDigits>
+    inline const Pow10Table &pow10_table()
+    {
+        static const Pow10Table table{MaxDigits};
+        return table;
+    }
+
+    /**
+     * @brief Десятичная запись числа a из n слов без ведущих нулей (общая часть toString для UBig и UInt).
+     * @details Цифры записываются в один заранее выделенный буфер из max_digits символов методом
+     * "разделяй и властвуй" (to_decimal).
+     */
+    inline std::string to_decimal_string(const u64 *a, size_t n, size_t max_digits, const Pow10Table &table)
+    {
+        if (normalized_size(a, n) == 0)
+            return "0";
+        std::string res(max_digits, '0');
+        to_decimal(a, n, res.data() + max_digits, max_digits, table);
+        res.erase(0, res.find_first_not_of('0'));
+        return res;
+    }
+
+    /**
+     * @brief Разбор десятичных цифр из [first, last) до первого нецифрового символа в число r из n слов
+     * по модулю 2^(64n) (общая часть fromString и from_chars для UBig и UInt).
+     * @details Длинные строки вне constexpr-вычислений разбираются рекурсивно по дереву степеней десяти (from_decimal),
+     * остальные - блоками до 19 цифр (SWAR/SIMD) с умножением на слово.
+     * @param table Функция, возвращающая таблицу степеней десяти; вызывается только для длинных строк.
+     * @param overflow Признак того, что число не поместилось в n слов (может быть nullptr).
+     * @return Указатель на первый неразобранный символ.
+     */
+    inline constexpr const char *parse_decimal(const char *first, const char *last, u64 *r, size_t n,
+                                               const Pow10Table &(*table)(), bool *overflow)
+    {
+        std::fill(r, r + n, 0);
+        if (!std::is_constant_evaluated())
+        {
+            const size_t ndigits = static_cast<size_t>(std::find_if_not(first, last, bignum::detail::is_digit) - first);
+            if (ndigits > FROM_DECIMAL_DC_THRESHOLD_DIGITS)
+            {
+                std::vector<u64> t(std::max(limbs_for_digits(ndigits), n));
+                from_decimal(first, ndigits, t.data(), t.size(), table());
+                std::copy_n(t.data(), n, r);
+                if (overflow)
+                    *overflow = normalized_size(t.data(), t.size()) > n;
+                return first + ndigits;
+            }
+        }
+        bool carried = false;
+        while (first != last)
+        {
+            u64 block;
+            const char *next = bignum::detail::parse_decimal_block(first, last, block);
+            if (next == first)
+                break;
+            // Вытесненное старшее слово r * 10^len + block - признак переполнения.
+            carried = mul_add_1(r, n, bignum::detail::POW10[next - first], block) != 0 || carried;
+            first = next;
+        }
+        if (overflow)
+            *overflow = carried;
+        return first;
+    }
+} // namespace bignum::limbs
@@ -10,6 +10,11 @@ int main()
     {
         using namespace bench;
         modulo_poly_calc();
+        powmod_calc();
+        pseudo_mersenne_calc();
+        multiplication_calc();
+        division_calc();
+        flat_ops_calc();
     }
     {
         using namespace tests_u128;
@@ -22,6 +27,8 @@ int main()
 
         testU128ToString();
 
+        to_chars_test();
+
         stressTestU128();
 
         cmp_operator_test();
@@ -56,6 +63,12 @@ int main()
 
         mult_mod_test();
 
+        montgomery_test();
+
+        barrett_test();
+
+        powmod_test();
+
         modular_inverse_test();
 
         quadratic_residue_test();
@@ -74,6 +87,8 @@ int main()
 
         debug_test();
 
+        to_chars_test();
+
         cmp_operator_test();
 
         addition_test();
@@ -98,6 +113,40 @@ int main()
 
         stress_test_u256();
 
+        divider_test();
+
+        from_chars_test();
+
+        to_string_test();
+
+        multiplication_test();
+
+        ntt_multiply_test();
+
+        division_test();
+
+        word_arithmetic_test();
+
+        flat_limbs_test();
+
+        carry_kernels_test();
+
+        uint_test();
+
+        square_test();
+
+        mulhi_test();
+
+        mul_wide_test();
+
+        montgomery_ubig_test();
+
+        fixed_base_pow_test();
+
+        multi_powmod_test();
+
+        pseudo_mersenne_test();
+
     }
 
     if (RUN_LONG_TESTS)
@@ -0,0 +1,639 @@
+/**
+ * @author nawww83@gmail.com
+ * @brief Модулярная арифметика в форме Монтгомери (нечетный модуль).
+ */
+
+#pragma once
+
+#include <cassert>
+#include <utility>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "u128.hpp"
+#include "ubig.hpp"
+#include "limbs.hpp"
+
+namespace bignum
+{
+
+    namespace detail
+    {
+        /**
+         * @brief Буфер из n элементов: на стеке, если помещается в Bytes байт, иначе в куче.
+         * @details Элементы на стеке не инициализируются (T - тривиально копируемый тип), поэтому каждый элемент
+         * нужно записать до чтения. Избавляет короткие вызовы (несколько оснований U128) от выделений памяти.
+         */
+        template <typename T, size_t Bytes = 2048>
+        class SmallBuffer
+        {
+            static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>);
+            static constexpr size_t CAPACITY = Bytes / sizeof(T);
+
+            alignas(T) unsigned char mFixed[CAPACITY == 0 ? 1 : CAPACITY * sizeof(T)];
+            std::vector<T> mHeap;
+            T *mData;
+
+        public:
+            explicit SmallBuffer(size_t n)
+            {
+                if (n <= CAPACITY)
+                {
+                    mData = std::launder(reinterpret_cast<T *>(mFixed));
+                }
+                else
+                {
+                    mHeap.resize(n);
+                    mData = mHeap.data();
+                }
+            }
+
+            SmallBuffer(const SmallBuffer &) = delete;
+            SmallBuffer &operator=(const SmallBuffer &) = delete;
+
+            [[nodiscard]] T *data() noexcept { return mData; }
+            [[nodiscard]] const T *data() const noexcept { return mData; }
+            T &operator[](size_t i) noexcept { return mData[i]; }
+            const T &operator[](size_t i) const noexcept { return mData[i]; }
+        };
+
+        /**
+         * @brief Ширина окна k для возведения в степень скользящим окном по битовой длине показателя.
+         * @details Окно k требует 2^(k-1) предвычисленных нечетных степеней и дает около bits / (k + 1) умножений;
+         * пороги - точки, где следующая ширина окна становится выгоднее.
+         */
+        inline constexpr int pow_window_size(uint32_t bits) noexcept
+        {
+            if (bits <= 7)
+                return 1;
+            if (bits <= 23)
+                return 2;
+            if (bits <= 79)
+                return 3;
+            if (bits <= 239)
+                return 4;
+            if (bits <= 671)
+                return 5;
+            return 6;
+        }
+
+        /**
+         * @brief Возведение в степень x^e скользящим окном "слева направо" в заданной арифметике.
+         * @param x Основание (в представлении арифметики).
+         * @param e Слова показателя, младшее первое.
+         * @param bits Битовая длина показателя.
+         * @param one Единица (в представлении арифметики).
+         * @param mul Произведение двух чисел в представлении арифметики.
+         */
+        template <typename T, typename Mul>
+        inline T sliding_window_power(const T &x, const uint64_t *e, uint32_t bits, const T &one, const Mul &mul)
+        {
+            const int k = pow_window_size(bits);
+            // Нечетные степени x, x^3, ..., x^(2^k - 1).
+            const size_t table_size = size_t{1} << (k - 1);
+            SmallBuffer<T> table(table_size);
+            table[0] = x;
+            if (table_size > 1)
+            {
+                const T x2 = mul(x, x);
+                for (size_t j = 1; j < table_size; ++j)
+                    table[j] = mul(table[j - 1], x2);
+            }
+            const auto bit = [e](int j) { return ((e[j / 64] >> (j % 64)) & 1ull) != 0; };
+            const int top = static_cast<int>(bits) - 1;
+            T result = one;
+            for (int i = top; i >= 0;)
+            {
+                if (!bit(i))
+                {
+                    result = mul(result, result);
+                    --i;
+                    continue;
+                }
+                // Окно [j, i] с единичными крайними битами.
+                int j = std::max(i - k + 1, 0);
+                while (!bit(j))
+                    ++j;
+                size_t window = 0;
+                for (int l = i; l >= j; --l)
+                    window = (window << 1) | (bit(l) ? 1u : 0u);
+                if (i == top)
+                {
+                    // Первое окно: возведение единицы в квадрат не нужно.
+                    result = table[window >> 1];
+                }
+                else
+                {
+                    for (int l = j; l <= i; ++l)
+                        result = mul(result, result);
+                    result = mul(result, table[window >> 1]);
+                }
+                i = j - 1;
+            }
+            return result;
+        }
+
+        /**
+         * @brief Слова числа (U128 или UBig), младшее первое.
+         */
+        template <typename T>
+        inline constexpr auto to_words(const T &x) noexcept
+        {
+            if constexpr (std::is_same_v<T, u128::U128>)
+                return std::array<uint64_t, 2>{x.low(), x.high()};
+            else
+                return x.to_limbs();
+        }
+
+        /**
+         * @brief Битовая длина числа из n слов.
+         */
+        inline uint32_t words_bit_width(const uint64_t *w, size_t n) noexcept
+        {
+            const size_t len = bignum::limbs::normalized_size(w, n);
+            return len == 0 ? 0 : static_cast<uint32_t>(64 * len - std::countl_zero(w[len - 1]));
+        }
+
+        /**
+         * @brief Биты [pos, pos + len) числа из n слов, len не больше 32; биты за пределами числа - нули.
+         */
+        inline uint32_t extract_bits(const uint64_t *w, size_t n, uint32_t pos, uint32_t len) noexcept
+        {
+            const size_t i = pos / 64;
+            const uint32_t shift = pos % 64;
+            if (i >= n)
+                return 0;
+            uint64_t v = w[i] >> shift;
+            if (shift != 0 && shift + len > 64 && i + 1 < n)
+                v |= w[i + 1] << (64 - shift);
+            return static_cast<uint32_t>(v & ((1ull << len) - 1));
+        }
+
+        /**
+         * @brief Произведение степеней prod x_i^e_i методом Штрауса с чередующимися скользящими окнами.
+         * @details У каждого основания своя таблица нечетных степеней и свои окна; цепочка возведений в квадрат
+         * общая, а умножение на элемент таблицы делается в бите, где оканчивается окно. Окна каждого показателя
+         * находятся по ходу общей цепочки: хранится только ближайшее окно.
+         */
+        template <typename T, typename Words, typename Mul>
+        inline T straus_power(const T *xs, const Words *es, size_t n, const T &one, const Mul &mul)
+        {
+            // Ширина окна, начало таблицы нечетных степеней и ближайшее окно: младший бит (-1 - окон нет) и значение.
+            struct Term
+            {
+                int k;
+                size_t offset;
+                int window_low;
+                uint32_t digit;
+            };
+            // Следующее окно показателя e с единичными крайними битами и старшим битом не выше p.
+            const auto next_window = [](Term &t, const Words &e, int p)
+            {
+                while (p >= 0 && extract_bits(e.data(), e.size(), p, 1) == 0)
+                    --p;
+                t.window_low = -1;
+                if (p < 0)
+                    return;
+                int j = std::max(p - t.k + 1, 0);
+                while (extract_bits(e.data(), e.size(), j, 1) == 0)
+                    ++j;
+                t.window_low = j;
+                t.digit = extract_bits(e.data(), e.size(), j, p - j + 1);
+            };
+            SmallBuffer<Term> terms(n);
+            size_t table_size = 0;
+            int max_bits = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                const int bits = static_cast<int>(words_bit_width(es[i].data(), es[i].size()));
+                terms[i].k = bits == 0 ? 1 : pow_window_size(bits);
+                terms[i].offset = table_size;
+                table_size += bits == 0 ? 0 : size_t{1} << (terms[i].k - 1);
+                max_bits = std::max(max_bits, bits);
+                next_window(terms[i], es[i], bits - 1);
+            }
+            // Таблицы нечетных степеней всех оснований подряд: x_i^(2t+1) лежит в table[offset_i + t].
+            SmallBuffer<T> table(table_size);
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (terms[i].window_low < 0)
+                    continue;
+                T *const t = table.data() + terms[i].offset;
+                t[0] = xs[i];
+                if (terms[i].k > 1)
+                {
+                    const T x2 = mul(xs[i], xs[i]);
+                    for (size_t j = 1; j < (size_t{1} << (terms[i].k - 1)); ++j)
+                        t[j] = mul(t[j - 1], x2);
+                }
+            }
+            T result = one;
+            bool started = false;
+            for (int p = max_bits - 1; p >= 0; --p)
+            {
+                if (started)
+                    result = mul(result, result);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    if (terms[i].window_low != p)
+                        continue;
+                    const T &y = table[terms[i].offset + (terms[i].digit >> 1)];
+                    result = started ? mul(result, y) : y;
+                    started = true;
+                    next_window(terms[i], es[i], p - 1);
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief Произведение степеней prod x_i^e_i методом Пиппенджера (корзины) с окном c бит.
+         * @details В каждом окне основания раскладываются по корзинам B[d] по значению d очередных c бит показателя,
+         * а prod B[d]^d = prod_d (prod_{d' >= d} B[d']) собирается двумя бегущими произведениями:
+         * n + 2^(c+1) умножений на окно независимо от числа оснований в корзине.
+         */
+        template <typename T, typename Words, typename Mul>
+        inline T pippenger_power(const T *xs, const Words *es, size_t n, uint32_t c, const T &one, const Mul &mul)
+        {
+            uint32_t max_bits = 0;
+            for (size_t i = 0; i < n; ++i)
+                max_bits = std::max(max_bits, words_bit_width(es[i].data(), es[i].size()));
+            const size_t buckets_count = size_t{1} << c;
+            SmallBuffer<T> buckets(buckets_count);
+            SmallBuffer<char> filled(buckets_count);
+            T result = one;
+            bool started = false;
+            for (uint32_t w = (max_bits + c - 1) / c; w-- > 0;)
+            {
+                if (started)
+                    for (uint32_t l = 0; l < c; ++l)
+                        result = mul(result, result);
+                std::fill_n(filled.data(), buckets_count, 0);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    const uint32_t d = extract_bits(es[i].data(), es[i].size(), w * c, c);
+                    if (d == 0)
+                        continue;
+                    buckets[d] = filled[d] ? mul(buckets[d], xs[i]) : xs[i];
+                    filled[d] = 1;
+                }
+                T acc = one;
+                T sum = one;
+                bool has_acc = false;
+                bool has_sum = false;
+                for (size_t d = buckets_count - 1; d > 0; --d)
+                {
+                    if (filled[d])
+                    {
+                        acc = has_acc ? mul(acc, buckets[d]) : buckets[d];
+                        has_acc = true;
+                    }
+                    if (has_acc)
+                    {
+                        sum = has_sum ? mul(sum, acc) : acc;
+                        has_sum = true;
+                    }
+                }
+                if (has_sum)
+                {
+                    result = started ? mul(result, sum) : sum;
+                    started = true;
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief Ширина окна c метода Пиппенджера, если он дешевле метода Штрауса, иначе 0.
+         * @details Оценка числа умножений сверх общих max_bits квадратов: sum_i (bits_i / (k_i + 1) + 2^(k_i - 1))
+         * у Штрауса против ceil(max_bits / c) * (n + 2^(c+1)) у Пиппенджера.
+         */
+        template <typename Words>
+        inline uint32_t pippenger_window(const Words *es, size_t n) noexcept
+        {
+            uint32_t max_bits = 0;
+            uint64_t straus_cost = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                const uint32_t bits = words_bit_width(es[i].data(), es[i].size());
+                max_bits = std::max(max_bits, bits);
+                if (bits != 0)
+                {
+                    const int k = pow_window_size(bits);
+                    straus_cost += bits / (k + 1) + (1u << (k - 1));
+                }
+            }
+            uint32_t best_c = 0;
+            uint64_t best_cost = straus_cost;
+            for (uint32_t c = 1; c <= 16 && max_bits != 0; ++c)
+            {
+                const uint64_t cost = uint64_t{(max_bits + c - 1) / c} * (n + (uint64_t{2} << c));
+                if (cost < best_cost)
+                {
+                    best_cost = cost;
+                    best_c = c;
+                }
+            }
+            return best_c;
+        }
+
+        /**
+         * @brief Произведение степеней prod x_i^e_i с общей цепочкой возведений в квадрат.
+         * @details Метод (Штраус или Пиппенджер с лучшей шириной окна) выбирается по pippenger_window.
+         * @param xs Основания (в представлении арифметики), n штук.
+         * @param es Слова показателей, младшее первое, n штук.
+         */
+        template <typename T, typename Words, typename Mul>
+        inline T multi_power(const T *xs, const Words *es, size_t n, const T &one, const Mul &mul)
+        {
+            if (const uint32_t c = pippenger_window(es, n); c != 0)
+                return pippenger_power(xs, es, n, c, one, mul);
+            return straus_power(xs, es, n, one, mul);
+        }
+    }
+
+    /**
+     * @brief Контекст арифметики Монтгомери по фиксированному нечетному модулю N.
+     * @details Числа хранятся в форме Монтгомери: x' = x * R mod N, где R = 2^w, w - разрядность типа T.
+     * Произведение x' * y' сводится к x * y * R mod N с помощью редукции REDC без деления.
+     * @tparam T Тип чисел (U128 или UBig любой разрядности).
+     */
+    template <typename T>
+    class MontgomeryContext;
+
+    /**
+     * @brief Контекст Монтгомери для 128-битного модуля, R = 2^128.
+     */
+    template <>
+    class MontgomeryContext<u128::U128>
+    {
+        using U128 = u128::U128;
+
+        /**
+         * @brief Модуль N.
+         */
+        U128 mN;
+
+        /**
+         * @brief Величина N' = -N^(-1) mod R.
+         */
+        U128 mNPrime;
+
+        /**
+         * @brief Величина R mod N (единица в форме Монтгомери).
+         */
+        U128 mR1;
+
+        /**
+         * @brief Величина R^2 mod N (для перевода в форму Монтгомери).
+         */
+        U128 mR2;
+
+    public:
+        /**
+         * @brief Конструктор.
+         * @param n Нечетный модуль.
+         */
+        constexpr explicit MontgomeryContext(const U128 &n) noexcept : mN{n}
+        {
+            assert((n.low() & 1ull) != 0);
+            // Метод Ньютона: каждая итерация удваивает число верных бит обратной величины.
+            // Начальное приближение N верно в 3 младших битах (N * N = 1 mod 8).
+            U128 inv = n;
+            for (int i = 0; i < 6; ++i)
+                inv *= U128{2} - n * inv;
+            mNPrime = -inv;
+            mR1 = (-n) % n;
+            // R^2 mod N = R * 2^128 mod N: 128 удвоений по модулю.
+            mR2 = mR1;
+            for (int i = 0; i < 128; ++i)
+                mR2 = add(mR2, mR2);
+        }
+
+        /**
+         * @brief Модуль.
+         */
+        [[nodiscard]] constexpr const U128 &modulus() const noexcept { return mN; }
+
+        /**
+         * @brief Единица в форме Монтгомери.
+         */
+        [[nodiscard]] constexpr const U128 &one() const noexcept { return mR1; }
+
+        /**
+         * @brief Редукция Монтгомери: T * R^(-1) mod N, где T = {low, high} < N * R.
+         */
+        [[nodiscard]] constexpr U128 redc(const U128 &low, const U128 &high) const noexcept
+        {
+            const U128 m = low * mNPrime;
+            const auto [mn_low, mn_high] = u128::mult_full(m, mN);
+            // low + mn_low = 0 mod R, поэтому перенос из младшей половины есть всегда, кроме случая low = 0.
+            const U128 carry{low ? 1ull : 0ull};
+            U128 t = high + mn_high;
+            bool overflow = t < high;
+            const U128 t_old = t;
+            t += carry;
+            overflow |= t < t_old;
+            if (overflow || t >= mN)
+                t -= mN;
+            return t;
+        }
+
+        /**
+         * @brief Перевод числа в форму Монтгомери: x * R mod N.
+         */
+        [[nodiscard]] constexpr U128 to_mont(const U128 &x) const noexcept
+        {
+            const auto [low, high] = u128::mult_full(x, mR2);
+            return redc(low, high);
+        }
+
+        /**
+         * @brief Перевод числа из формы Монтгомери: x * R^(-1) mod N.
+         */
+        [[nodiscard]] constexpr U128 from_mont(const U128 &x) const noexcept
+        {
+            return redc(x, U128{0});
+        }
+
+        /**
+         * @brief Произведение в форме Монтгомери.
+         */
+        [[nodiscard]] constexpr U128 mul(const U128 &x, const U128 &y) const noexcept
+        {
+            const auto [low, high] = u128::mult_full(x, y);
+            return redc(low, high);
+        }
+
+        /**
+         * @brief Квадрат в форме Монтгомери.
+         */
+        [[nodiscard]] constexpr U128 sqr(const U128 &x) const noexcept
+        {
+            return mul(x, x);
+        }
+
+        /**
+         * @brief Сумма по модулю N (аргументы меньше N).
+         */
+        [[nodiscard]] constexpr U128 add(const U128 &x, const U128 &y) const noexcept
+        {
+            const U128 s = x + y;
+            return (s < x || s >= mN) ? s - mN : s;
+        }
+
+        /**
+         * @brief Разность по модулю N (аргументы меньше N).
+         */
+        [[nodiscard]] constexpr U128 sub(const U128 &x, const U128 &y) const noexcept
+        {
+            return (x >= y) ? x - y : x - y + mN;
+        }
+
+        /**
+         * @brief Возведение в степень в форме Монтгомери (бинарный метод "слева направо").
+         * @param x Основание в форме Монтгомери.
+         * @param e Показатель степени.
+         * @return x^e в форме Монтгомери.
+         */
+        [[nodiscard]] constexpr U128 pow(const U128 &x, const U128 &e) const noexcept
+        {
+            U128 result = mR1;
+            for (int i = static_cast<int>(e.bit_width()) - 1; i >= 0; --i)
+            {
+                result = sqr(result);
+                if (((i >= 64 ? e.high() >> (i - 64) : e.low() >> i) & 1ull) != 0)
+                    result = mul(result, x);
+            }
+            return result;
+        }
+    };
+
+    /**
+     * @brief Контекст Монтгомери для модуля UBig любой разрядности, R = 2^WIDTH = B^LIMBS.
+     * @details Умножение с редукцией идет над "плоским" представлением (limbs::mont_mul, метод CIOS):
+     * нужна лишь величина -N^(-1) mod 2^64, а R mod N и R^2 mod N вычисляются один раз в конструкторе.
+     */
+    template <typename ULOW>
+    class MontgomeryContext<UBig<ULOW>>
+    {
+        using U = UBig<ULOW>;
+        static constexpr size_t LIMBS = U::LIMBS;
+
+        /**
+         * @brief Модуль N.
+         */
+        U mN;
+
+        /**
+         * @brief Величина -N^(-1) mod 2^64.
+         */
+        uint64_t mNPrime{0};
+
+        /**
+         * @brief Величина R mod N (единица в форме Монтгомери).
+         */
+        U mR1;
+
+        /**
+         * @brief Величина R^2 mod N (для перевода в форму Монтгомери).
+         */
+        U mR2;
+
+    public:
+        /**
+         * @brief Конструктор.
+         * @param n Нечетный модуль.
+         */
+        constexpr explicit MontgomeryContext(const U &n) noexcept : mN{n}
+        {
+            const auto limbs = n.to_limbs();
+            assert((limbs[0] & 1ull) != 0);
+            mNPrime = bignum::limbs::neg_inverse_u64(limbs[0]);
+            mR1 = (-n) % n;
+            // R^2 mod N = (R mod N) * R mod N: одно деление 2N/N.
+            UBig<U>::template divide<false, true>(UBig<U>{U{0}, mR1}, n, &mR2);
+        }
+
+        /**
+         * @brief Модуль.
+         */
+        [[nodiscard]] constexpr const U &modulus() const noexcept { return mN; }
+
+        /**
+         * @brief Единица в форме Монтгомери.
+         */
+        [[nodiscard]] constexpr const U &one() const noexcept { return mR1; }
+
+        /**
+         * @brief Произведение в форме Монтгомери: x * y * R^(-1) mod N (достаточно, чтобы один из множителей был меньше N).
+         */
+        [[nodiscard]] constexpr U mul(const U &x, const U &y) const noexcept
+        {
+            auto a = x.to_limbs();
+            const auto b = y.to_limbs();
+            const auto n = mN.to_limbs();
+            std::array<uint64_t, 2 * LIMBS + 1> t;
+            bignum::limbs::mont_mul(a.data(), a.data(), b.data(), n.data(), mNPrime, LIMBS, t.data());
+            return U::from_limbs(a);
+        }
+
+        /**
+         * @brief Квадрат в форме Монтгомери.
+         */
+        [[nodiscard]] constexpr U sqr(const U &x) const noexcept
+        {
+            return mul(x, x);
+        }
+
+        /**
+         * @brief Перевод числа в форму Монтгомери: x * R mod N.
+         */
+        [[nodiscard]] constexpr U to_mont(const U &x) const noexcept
+        {
+            return mul(x, mR2);
+        }
+
+        /**
+         * @brief Перевод числа из формы Монтгомери: x * R^(-1) mod N.
+         */
+        [[nodiscard]] constexpr U from_mont(const U &x) const noexcept
+        {
+            return mul(x, U{1});
+        }
+
+        /**
+         * @brief Сумма по модулю N (аргументы меньше N).
+         */
+        [[nodiscard]] constexpr U add(const U &x, const U &y) const noexcept
+        {
+            const U s = x + y;
+            return (s < x || s >= mN) ? s - mN : s;
+        }
+
+        /**
+         * @brief Разность по модулю N (аргументы меньше N).
+         */
+        [[nodiscard]] constexpr U sub(const U &x, const U &y) const noexcept
+        {
+            return (x >= y) ? x - y : x - y + mN;
+        }
+
+        /**
+         * @brief Возведение в степень в форме Монтгомери скользящим окном.
+         * @param x Основание в форме Монтгомери.
+         * @param e Показатель степени.
+         * @return x^e в форме Монтгомери.
+         */
+        [[nodiscard]] U pow(const U &x, const U &e) const
+        {
+            const auto exponent = e.to_limbs();
+            const auto mul_mont = [this](const U &a, const U &b) { return mul(a, b); };
+            return detail::sliding_window_power(x, exponent.data(), e.bit_width(), mR1, mul_mont);
+        }
+    };
+
+} // namespace bignum
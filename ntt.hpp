@@ -0,0 +1,322 @@
+/**
+ * @author nawww83@gmail.com
+ * @brief Умножение длинных чисел через теоретико-числовое преобразование (NTT) по трем 62-битным простым модулям
+ * с восстановлением коэффициентов по китайской теореме об остатках (схема Гарнера).
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <bit>
+#include <vector>
+#include <algorithm>
+#include "u128.hpp"
+#include "limbs.hpp"
+
+namespace bignum
+{
+    namespace ntt
+    {
+        using u64 = uint64_t;
+
+        /**
+         * @brief Арифметика по простому модулю p = c * 2^k + 1 < 2^62 в форме Монтгомери, R = 2^64.
+         * @details Произведения считаются через U128::mult_ext, редукция - без деления.
+         */
+        class PrimeField
+        {
+            /**
+             * @brief Модуль p.
+             */
+            u64 mP;
+
+            /**
+             * @brief Величина p^(-1) mod 2^64.
+             */
+            u64 mPInv;
+
+            /**
+             * @brief Величина R mod p (единица в форме Монтгомери).
+             */
+            u64 mR1;
+
+            /**
+             * @brief Величина R^2 mod p.
+             */
+            u64 mR2;
+
+            /**
+             * @brief Первообразный корень по модулю p.
+             */
+            u64 mGenerator;
+
+        public:
+            /**
+             * @brief Конструктор.
+             * @param p Простой модуль вида c * 2^k + 1, меньший 2^62.
+             * @param generator Первообразный корень по модулю p.
+             */
+            constexpr PrimeField(u64 p, u64 generator) noexcept : mP{p}, mGenerator{generator}
+            {
+                // Метод Ньютона: p * p = 1 mod 8, каждая итерация удваивает число верных бит.
+                u64 inv = p;
+                for (int i = 0; i < 5; ++i)
+                    inv *= 2 - p * inv;
+                mPInv = inv;
+                mR1 = (0 - p) % p;
+                const u128::U128 r2 = u128::U128::mult_ext(mR1, mR1);
+                bignum::limbs::div_2by1(r2.high(), r2.low(), p, &mR2);
+            }
+
+            /**
+             * @brief Модуль.
+             */
+            [[nodiscard]] constexpr u64 modulus() const noexcept { return mP; }
+
+            /**
+             * @brief Единица в форме Монтгомери.
+             */
+            [[nodiscard]] constexpr u64 one() const noexcept { return mR1; }
+
+            /**
+             * @brief Произведение x * y * R^(-1) mod p (x * y < p * R).
+             */
+            [[nodiscard]] constexpr u64 mul(u64 x, u64 y) const noexcept
+            {
+                const u128::U128 t = u128::U128::mult_ext(x, y);
+                const u64 m = t.low() * mPInv;
+                // Младшее слово t - m * p равно нулю, поэтому заема из него нет.
+                const u64 mp_high = u128::U128::mult_ext(m, mP).high();
+                const u64 r = t.high() - mp_high;
+                return t.high() < mp_high ? r + mP : r;
+            }
+
+            /**
+             * @brief Сумма по модулю p (аргументы меньше p).
+             */
+            [[nodiscard]] constexpr u64 add(u64 x, u64 y) const noexcept
+            {
+                const u64 s = x + y;
+                return s >= mP ? s - mP : s;
+            }
+
+            /**
+             * @brief Разность по модулю p (аргументы меньше p).
+             */
+            [[nodiscard]] constexpr u64 sub(u64 x, u64 y) const noexcept
+            {
+                return x >= y ? x - y : x - y + mP;
+            }
+
+            /**
+             * @brief Перевод в форму Монтгомери (x < p).
+             */
+            [[nodiscard]] constexpr u64 to_mont(u64 x) const noexcept { return mul(x, mR2); }
+
+            /**
+             * @brief Перевод из формы Монтгомери.
+             */
+            [[nodiscard]] constexpr u64 from_mont(u64 x) const noexcept { return mul(x, 1); }
+
+            /**
+             * @brief Возведение в степень в форме Монтгомери.
+             */
+            [[nodiscard]] constexpr u64 pow(u64 x, u64 e) const noexcept
+            {
+                u64 result = mR1;
+                for (; e != 0; e >>= 1)
+                {
+                    if (e & 1)
+                        result = mul(result, x);
+                    x = mul(x, x);
+                }
+                return result;
+            }
+
+            /**
+             * @brief Первообразный корень степени n = 2^log из единицы в форме Монтгомери.
+             */
+            [[nodiscard]] constexpr u64 root_of_unity(int log) const noexcept
+            {
+                return pow(to_mont(mGenerator), (mP - 1) >> log);
+            }
+        };
+
+        /**
+         * @brief Простые модули c * 2^50 + 1 и их первообразные корни. Произведение модулей больше 2^185, что
+         * покрывает коэффициенты свертки min(na, nb) * (2^64 - 1)^2 при длине до 2^57 слов.
+         */
+        inline constexpr PrimeField PRIMES[3]{
+            {0x3FDC000000000001ull, 3},
+            {0x3F18000000000001ull, 10},
+            {0x3EC4000000000001ull, 37}};
+
+        /**
+         * @brief Наибольшая длина преобразования: все модули имеют вид c * 2^50 + 1.
+         */
+        inline constexpr int MAX_LOG_LENGTH = 50;
+
+        /**
+         * @brief Таблица корней: roots[h + j] = w^j, где w - первообразный корень степени 2h (форма Монтгомери),
+         * h = 1, 2, 4, ..., n / 2. Для обратного преобразования берутся обратные корни.
+         * @tparam K Номер модуля в PRIMES; модуль известен при компиляции, и редукция сводится к умножениям на константы.
+         */
+        template <size_t K>
+        std::vector<u64> make_roots(size_t n, bool inverse)
+        {
+            constexpr const PrimeField &f = PRIMES[K];
+            std::vector<u64> roots(std::max<size_t>(n, 2));
+            for (size_t h = 1; h < n; h *= 2)
+            {
+                u64 w = f.root_of_unity(std::countr_zero(2 * h));
+                if (inverse)
+                    w = f.pow(w, 2 * h - 1);
+                roots[h] = f.one();
+                for (size_t j = 1; j < h; ++j)
+                    roots[h + j] = f.mul(roots[h + j - 1], w);
+            }
+            return roots;
+        }
+
+        /**
+         * @brief Прямое преобразование (прореживание по частоте): естественный порядок на входе,
+         * бит-реверсный на выходе.
+         */
+        template <size_t K>
+        void forward(u64 *a, size_t n, const std::vector<u64> &roots)
+        {
+            constexpr const PrimeField &f = PRIMES[K];
+            for (size_t h = n / 2; h >= 1; h /= 2)
+            {
+                for (size_t i = 0; i < n; i += 2 * h)
+                {
+                    for (size_t j = 0; j < h; ++j)
+                    {
+                        const u64 u = a[i + j];
+                        const u64 v = a[i + j + h];
+                        a[i + j] = f.add(u, v);
+                        a[i + j + h] = f.mul(f.sub(u, v), roots[h + j]);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Обратное преобразование без нормировки (прореживание по времени): бит-реверсный порядок на входе,
+         * естественный на выходе.
+         */
+        template <size_t K>
+        void inverse(u64 *a, size_t n, const std::vector<u64> &roots)
+        {
+            constexpr const PrimeField &f = PRIMES[K];
+            for (size_t h = 1; h < n; h *= 2)
+            {
+                for (size_t i = 0; i < n; i += 2 * h)
+                {
+                    for (size_t j = 0; j < h; ++j)
+                    {
+                        const u64 u = a[i + j];
+                        const u64 v = f.mul(a[i + j + h], roots[h + j]);
+                        a[i + j] = f.add(u, v);
+                        a[i + j + h] = f.sub(u, v);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Циклическая свертка слов a и b по модулю PRIMES[K] длины n (степень двойки, n >= na + nb - 1).
+         * @param out Коэффициенты свертки по модулю в обычной форме, n элементов.
+         * @details Входы не переводятся в форму Монтгомери: корни в форме Монтгомери сохраняют обычную форму
+         * при преобразовании, а лишний множитель R^(-1) поточечного произведения компенсируется при нормировке.
+         */
+        template <size_t K>
+        void convolve(const u64 *a, size_t na, const u64 *b, size_t nb, size_t n, std::vector<u64> &out)
+        {
+            constexpr const PrimeField &f = PRIMES[K];
+            constexpr u64 p = f.modulus();
+            const std::vector<u64> roots = make_roots<K>(n, false);
+            out.assign(n, 0);
+            for (size_t i = 0; i < na; ++i)
+                out[i] = a[i] % p;
+            forward<K>(out.data(), n, roots);
+            if (a == b && na == nb)
+            {
+                for (size_t i = 0; i < n; ++i)
+                    out[i] = f.mul(out[i], out[i]);
+            }
+            else
+            {
+                std::vector<u64> fb(n);
+                for (size_t i = 0; i < nb; ++i)
+                    fb[i] = b[i] % p;
+                forward<K>(fb.data(), n, roots);
+                for (size_t i = 0; i < n; ++i)
+                    out[i] = f.mul(out[i], fb[i]);
+            }
+            inverse<K>(out.data(), n, make_roots<K>(n, true));
+            // n^(-1) = p - (p - 1) / n; множитель n^(-1) * R^2 снимает и нормировку, и R^(-1).
+            const u64 scale = f.to_mont(f.to_mont(p - (p - 1) / n));
+            for (size_t i = 0; i < n; ++i)
+                out[i] = f.mul(out[i], scale);
+        }
+
+        /**
+         * @brief Константы схемы Гарнера в форме Монтгомери: p1^(-1) mod p2, p1^(-1) mod p3, p2^(-1) mod p3.
+         */
+        inline constexpr u64 INV_P1_MOD_P2 = PRIMES[1].pow(PRIMES[1].to_mont(PRIMES[0].modulus() - PRIMES[1].modulus()),
+                                                            PRIMES[1].modulus() - 2);
+        inline constexpr u64 INV_P1_MOD_P3 = PRIMES[2].pow(PRIMES[2].to_mont(PRIMES[0].modulus() - PRIMES[2].modulus()),
+                                                            PRIMES[2].modulus() - 2);
+        inline constexpr u64 INV_P2_MOD_P3 = PRIMES[2].pow(PRIMES[2].to_mont(PRIMES[1].modulus() - PRIMES[2].modulus()),
+                                                            PRIMES[2].modulus() - 2);
+
+        /**
+         * @brief Приведение x < 2p по модулю p.
+         */
+        inline constexpr u64 reduce_once(u64 x, u64 p) noexcept { return x >= p ? x - p : x; }
+    } // namespace ntt
+
+    /**
+     * @brief Умножение через NTT: r = a * b, r из na + nb слов и не пересекается с a и b.
+     * @details Свертка 64-битных слов считается по трем простым модулям, каждый коэффициент восстанавливается
+     * схемой Гарнера x = v1 + p1 * (v2 + p2 * v3) и сразу добавляется к результату с переносом.
+     * Сложность O(n log n); при a == b и na == nb прямое преобразование выполняется один раз на модуль.
+     */
+    inline void ntt_multiply(uint64_t *r, const uint64_t *a, size_t na, const uint64_t *b, size_t nb)
+    {
+        using ntt::u64;
+        using ntt::PRIMES;
+        using u128::U128;
+        const size_t n = std::bit_ceil(na + nb);
+        assert(std::countr_zero(n) <= ntt::MAX_LOG_LENGTH);
+        std::vector<u64> c1, c2, c3;
+        ntt::convolve<0>(a, na, b, nb, n, c1);
+        ntt::convolve<1>(a, na, b, nb, n, c2);
+        ntt::convolve<2>(a, na, b, nb, n, c3);
+        const u64 p1 = PRIMES[0].modulus();
+        const u64 p2 = PRIMES[1].modulus();
+        const u64 p3 = PRIMES[2].modulus();
+        // Накопитель переноса: коэффициент меньше 2^186, перенос меньше 2^123, сумма помещается в три слова.
+        u64 acc[3]{};
+        for (size_t i = 0; i < na + nb; ++i)
+        {
+            const u64 v1 = c1[i];
+            // p1 < 2 * p2 и p1 < 2 * p3, поэтому приведение v1 требует не более одного вычитания.
+            const u64 v2 = PRIMES[1].mul(PRIMES[1].sub(c2[i], ntt::reduce_once(v1, p2)), ntt::INV_P1_MOD_P2);
+            const u64 t3 = PRIMES[2].mul(PRIMES[2].sub(c3[i], ntt::reduce_once(v1, p3)), ntt::INV_P1_MOD_P3);
+            const u64 v3 = PRIMES[2].mul(PRIMES[2].sub(t3, ntt::reduce_once(v2, p3)), ntt::INV_P2_MOD_P3);
+            const U128 inner = U128::mult_ext(p2, v3) + U128{v2};
+            const U128 lo = U128::mult_ext(p1, inner.low()) + U128{v1};
+            const U128 hi = U128::mult_ext(p1, inner.high()) + U128{lo.high()};
+            const u64 x[3]{lo.low(), hi.low(), hi.high()};
+            bignum::limbs::add_n(acc, acc, x, 3);
+            r[i] = acc[0];
+            acc[0] = acc[1];
+            acc[1] = acc[2];
+            acc[2] = 0;
+        }
+    }
+} // namespace bignum
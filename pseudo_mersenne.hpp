@@ -0,0 +1,220 @@
+/**
+ * @author nawww83@gmail.com
+ * @brief Арифметика по модулю вида 2^k - c (псевдомерсенновы простые 2^127 - 1, 2^255 - 19 и т.п.).
+ */
+
+#pragma once
+
+#include <cassert>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include "u128.hpp"
+#include "ubig.hpp"
+#include "limbs.hpp"
+#include "montgomery.hpp"
+
+namespace bignum
+{
+
+    namespace detail
+    {
+        /**
+         * @brief Наименьший тип (U128 или UBig) разрядностью не меньше bits.
+         */
+        template <uint32_t bits>
+        struct uint_for_bits
+        {
+            using type = UBig<typename uint_for_bits<(bits + 1) / 2>::type>;
+        };
+
+        template <uint32_t bits>
+            requires(bits <= 128)
+        struct uint_for_bits<bits>
+        {
+            using type = u128::U128;
+        };
+    }
+
+    /**
+     * @brief Поле (кольцо) вычетов по модулю p = 2^Bits - C.
+     * @details Так как 2^Bits = C (mod p), произведение P = H * 2^Bits + L сводится к H * C + L без деления:
+     * два "сворачивания" с умножением на слово C и одно условное вычитание p. Параметры - константы времени
+     * компиляции, поэтому сдвиги, маски и множитель подставляются компилятором.
+     * Элементы поля - числа типа value_type из диапазона [0, p).
+     * @tparam Bits Показатель k: от 65 до разрядности типа хранения.
+     * @tparam C Малая константа c: 1 <= c < 2^32.
+     */
+    template <uint32_t Bits, uint64_t C>
+    class PseudoMersenneField
+    {
+    public:
+        /**
+         * @brief Тип хранения: наименьший U128 или UBig, вмещающий Bits бит.
+         */
+        using value_type = typename detail::uint_for_bits<Bits>::type;
+
+        static constexpr uint32_t WIDTH = static_cast<uint32_t>(bignum::generic::bit_size<value_type>());
+
+        static_assert(Bits > 64 && Bits <= WIDTH, "Bits must be in (64, WIDTH]");
+        static_assert(C >= 1 && C < (uint64_t{1} << 32), "C must be in [1, 2^32)");
+
+    private:
+        using T = value_type;
+        using Wide = UBig<T>;
+
+        /**
+         * @brief Число 64-битных слов типа хранения.
+         */
+        static constexpr size_t N = WIDTH / 64;
+
+        using Words = std::array<uint64_t, N>;
+
+        /**
+         * @brief Номер слова и сдвиг бита 2^Bits.
+         */
+        static constexpr size_t OFFSET = Bits / 64;
+        static constexpr unsigned SHIFT = Bits % 64;
+
+        static constexpr Words modulus_words() noexcept
+        {
+            Words m{};
+            for (size_t i = 0; i < OFFSET; ++i)
+                m[i] = ~uint64_t{0};
+            if constexpr (SHIFT != 0)
+                m[OFFSET] = (uint64_t{1} << SHIFT) - 1;
+            m[0] -= C - 1;
+            return m;
+        }
+
+        /**
+         * @brief Слова модуля, младшее первое.
+         */
+        static constexpr Words MODULUS = modulus_words();
+
+        static constexpr T from_words(const Words &w) noexcept
+        {
+            if constexpr (std::is_same_v<T, u128::U128>)
+                return T{w[0], w[1]};
+            else
+                return T::from_limbs(w);
+        }
+
+        /**
+         * @brief Приведение числа из 2N слов, меньшего 2^(2 * Bits), по модулю p.
+         */
+        static constexpr T reduce_words(const uint64_t *x) noexcept
+        {
+            // L = x mod 2^Bits, H = x >> Bits (H < 2^Bits).
+            Words t;
+            Words h;
+            for (size_t i = 0; i < N; ++i)
+            {
+                t[i] = x[i];
+                const size_t j = OFFSET + i;
+                const uint64_t lo = j < 2 * N ? x[j] : 0;
+                if constexpr (SHIFT != 0)
+                    h[i] = (lo >> SHIFT) | (j + 1 < 2 * N ? x[j + 1] << (64 - SHIFT) : 0);
+                else
+                    h[i] = lo;
+            }
+            const auto clear_high = [&t]()
+            {
+                if constexpr (Bits < WIDTH)
+                {
+                    if constexpr (SHIFT != 0)
+                        t[OFFSET] &= (uint64_t{1} << SHIFT) - 1;
+                    for (size_t i = OFFSET + (SHIFT != 0 ? 1 : 0); i < N; ++i)
+                        t[i] = 0;
+                }
+            };
+            clear_high();
+            // Первое сворачивание: k * 2^WIDTH + t = H * C + L < 2^Bits * (C + 1).
+            const uint64_t k = bignum::limbs::addmul_1(t.data(), h.data(), N, C);
+            // Второе сворачивание: частное q от деления на 2^Bits не больше C.
+            const auto word = [&t, k](size_t i) { return i < N ? t[i] : (i == N ? k : 0); };
+            uint64_t q = word(OFFSET) >> SHIFT;
+            if constexpr (SHIFT != 0)
+                q |= word(OFFSET + 1) << (64 - SHIFT);
+            clear_high();
+            // t + q * C < 2^Bits + C^2; перенос возможен только при Bits == WIDTH и дает еще C.
+            if (bignum::limbs::add_1(t.data(), N, q * C) != 0)
+                bignum::limbs::add_1(t.data(), N, C);
+            if (bignum::limbs::cmp_n(t.data(), MODULUS.data(), N) >= 0)
+                bignum::limbs::sub_n(t.data(), t.data(), MODULUS.data(), N);
+            return from_words(t);
+        }
+
+    public:
+        /**
+         * @brief Модуль p = 2^Bits - C.
+         */
+        static constexpr T modulus() noexcept { return from_words(MODULUS); }
+
+        /**
+         * @brief Приведение двойного слова x < 2^(2 * Bits) по модулю p.
+         */
+        static constexpr T reduce(const Wide &x) noexcept { return reduce_words(detail::to_words(x).data()); }
+
+        /**
+         * @brief Приведение произвольного числа типа value_type по модулю p.
+         */
+        static constexpr T reduce(const T &x) noexcept { return reduce(Wide{x, T{0}}); }
+
+        /**
+         * @brief Произведение (a * b) mod p.
+         */
+        static constexpr T mul(const T &a, const T &b) noexcept
+        {
+            const auto x = detail::to_words(a);
+            const auto y = detail::to_words(b);
+            std::array<uint64_t, 2 * N> r;
+            bignum::limbs::mul_basecase(r.data(), x.data(), N, y.data(), N);
+            return reduce_words(r.data());
+        }
+
+        /**
+         * @brief Квадрат a^2 mod p.
+         */
+        static constexpr T sqr(const T &a) noexcept { return mul(a, a); }
+
+        /**
+         * @brief Сумма (a + b) mod p.
+         */
+        static constexpr T add(const T &a, const T &b) noexcept
+        {
+            T s = a + b;
+            if (s < a || s >= modulus())
+                s -= modulus();
+            return s;
+        }
+
+        /**
+         * @brief Разность (a - b) mod p.
+         */
+        static constexpr T sub(const T &a, const T &b) noexcept
+        {
+            return a >= b ? a - b : a + (modulus() - b);
+        }
+
+        /**
+         * @brief Степень x^e mod p скользящим окном.
+         */
+        static T pow(const T &x, const T &e)
+        {
+            const auto words = detail::to_words(e);
+            const auto mul_op = [](const T &a, const T &b) { return mul(a, b); };
+            return detail::sliding_window_power(x, words.data(), e.bit_width(), reduce(T{1}), mul_op);
+        }
+
+        /**
+         * @brief Обратный элемент x^(p - 2) mod p (для простого p и x != 0).
+         */
+        static T inv(const T &x)
+        {
+            assert(x != T{0});
+            return pow(x, modulus() - T{2});
+        }
+    };
+
+} // namespace bignum
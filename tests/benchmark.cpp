@@ -1,19 +1,49 @@
 #include <iostream>
+#include <cassert>
+#include <vector>
 #include "benchmark.hpp"
 #include "../u128.hpp"
 #include "../ubig.hpp"
+#include "../montgomery.hpp"
+#include "../u128_utils.hpp"
+#include "../fixed_base_pow.hpp"
+#include "../pseudo_mersenne.hpp"
+#include "../ntt.hpp"
 
 using namespace bignum;
 
 namespace bench {
     using U128 = u128::U128;
     using U256 = UBig<U128>;
+    using U512 = UBig<U256>;
+    using U1024 = UBig<U512>;
+    using U2048 = UBig<U1024>;
+    using U4096 = UBig<U2048>;
+    using U8192 = UBig<U4096>;
+
+    // Длина цепочки модулярных возведений в квадрат.
+    constexpr int CHAIN_LENGTH = 1000;
 
     U128 poly_mod(const U128& x, const U128& p) {
         U256 y = U256::square_ext(x);
         const auto& [q, r] = y / p;
         return r;
     }
+
+    U128 poly_mod_chain(const U128& x, const U128& p) {
+        U128 y = x;
+        for (int i = 0; i < CHAIN_LENGTH; ++i)
+            y = poly_mod(y, p);
+        return y;
+    }
+
+    U128 poly_mod_montgomery_chain(const U128& x, const U128& p) {
+        const MontgomeryContext<U128> ctx{p};
+        U128 y = ctx.to_mont(x);
+        for (int i = 0; i < CHAIN_LENGTH; ++i)
+            y = ctx.sqr(y);
+        return ctx.from_mont(y);
+    }
     
     void modulo_poly_calc()
     {
@@ -21,5 +51,560 @@ namespace bench {
         U128 p{1857756895516871747ull};
         auto duration = benchmark<U128>(poly_mod, x, p);
         std::cout << "Duration: " << duration << '\n';
+        assert(poly_mod_chain(x, p) == poly_mod_montgomery_chain(x, p));
+        auto duration_div = benchmark<U128>(poly_mod_chain, x, p);
+        auto duration_mont = benchmark<U128>(poly_mod_montgomery_chain, x, p);
+        std::cout << "Chain of " << CHAIN_LENGTH << " squares mod p, division: " << duration_div
+                  << ", Montgomery: " << duration_mont << '\n';
+    }
+
+    // Возведение в степень по модулю: бинарный метод через mult_mod (деление 256/128 на каждом шаге) против powmod.
+    U128 naive_powmod_series(const U128& x, const U128& m) {
+        U128 acc = 0;
+        for (uint64_t i = 0; i < 100; ++i) {
+            U128 e = ~U128{i};
+            U128 b = x % m;
+            U128 r = U128{1};
+            for (; e != 0; e >>= 1) {
+                if ((e.low() & 1ull) != 0)
+                    r = u128_utils::mult_mod(r, b, m);
+                b = u128_utils::mult_mod(b, b, m);
+            }
+            acc += r;
+        }
+        return acc;
+    }
+
+    U128 powmod_series(const U128& x, const U128& m) {
+        U128 acc = 0;
+        for (uint64_t i = 0; i < 100; ++i)
+            acc += u128_utils::powmod(x, ~U128{i}, m);
+        return acc;
+    }
+
+    // Возведение в степень по модулю для UBig: бинарный метод с делением на каждом шаге против powmod (Монтгомери).
+    template <typename T>
+    T naive_powmod_ubig(const T& x, const T& e, const T& m) {
+        const auto mod_mul = [&m](const T& a, const T& b) {
+            T r;
+            UBig<T>::template divide<false, true>(UBig<T>::mult_ext(a, b), m, &r);
+            return r;
+        };
+        T r{1};
+        for (int i = static_cast<int>(e.bit_width()) - 1; i >= 0; --i) {
+            r = mod_mul(r, r);
+            if (((e >> i).to_limbs()[0] & 1ull) != 0)
+                r = mod_mul(r, x);
+        }
+        return r;
+    }
+
+    template <typename T>
+    void powmod_ubig_calc(const char* name) {
+        const T m = T::max().divrem_u64(3).first | T{1};
+        const T x = T::max().divrem_u64(7).first % m;
+        const T e = ~m;
+        assert(naive_powmod_ubig(x, e, m) == u128_utils::powmod(x, e, m));
+        auto duration_naive = benchmark<T>(naive_powmod_ubig<T>, x, e, m);
+        auto duration_powmod = benchmark<T>(u128_utils::powmod<typename T::value_type>, x, e, m);
+        std::cout << "Power mod odd " << name << " m with a full-width exponent, division: " << duration_naive
+                  << ", Montgomery: " << duration_powmod << '\n';
+    }
+
+    // Фиксированное основание: powmod против FixedBasePow::pow (таблица строится один раз, вне замера).
+    template <typename T>
+    T fixed_base_series(const FixedBasePow<T>* fixed, const T& g, const T& m) {
+        T acc{0};
+        T e = m;
+        for (int i = 0; i < 100; ++i) {
+            e = e * T{0x9E3779B97F4A7C15ull} + T{1};
+            acc += fixed ? fixed->pow(e) : u128_utils::powmod(g, e, m);
+        }
+        return acc;
+    }
+
+    template <typename T>
+    void fixed_base_calc(const char* name, const T& m) {
+        const T g{5};
+        const FixedBasePow<T> fixed{g, m};
+        assert(fixed_base_series<T>(nullptr, g, m) == fixed_base_series(&fixed, g, m));
+        auto duration_powmod = benchmark<T>(fixed_base_series<T>, nullptr, g, m);
+        auto duration_fixed = benchmark<T>(fixed_base_series<T>, &fixed, g, m);
+        std::cout << "100 powers of a fixed base mod " << name << " m, powmod: " << duration_powmod
+                  << ", FixedBasePow: " << duration_fixed << '\n';
+    }
+
+    // Произведение степеней: отдельные powmod и mult_mod против multi_powmod с общей цепочкой квадратов
+    // (серия из reps вычислений с разными показателями).
+    template <typename T>
+    T separate_powmods(const std::vector<T>& bases, std::vector<T> exps, const T& m, int reps) {
+        T acc{0};
+        for (int k = 0; k < reps; ++k) {
+            exps[0] += T{1};
+            T r = T{1};
+            for (size_t i = 0; i < bases.size(); ++i) {
+                const T p = u128_utils::powmod(bases[i], exps[i], m);
+                if constexpr (std::is_same_v<T, U128>)
+                    r = u128_utils::mult_mod(r, p, m);
+                else
+                    UBig<T>::template divide<false, true>(UBig<T>::mult_ext(T{r}, p), m, &r);
+            }
+            acc += r;
+        }
+        return acc;
+    }
+
+    template <typename T>
+    T joint_powmods(const std::vector<T>& bases, std::vector<T> exps, const T& m, int reps) {
+        T acc{0};
+        for (int k = 0; k < reps; ++k) {
+            exps[0] += T{1};
+            acc += u128_utils::multi_powmod(bases, exps, m);
+        }
+        return acc;
+    }
+
+    template <typename T>
+    void multi_powmod_calc(const char* name, const T& m, size_t terms, int reps) {
+        std::vector<T> bases(terms), exps(terms);
+        T x = m;
+        for (size_t i = 0; i < terms; ++i) {
+            x = x * T{0x9E3779B97F4A7C15ull} + T{1};
+            bases[i] = x % m;
+            x = x * T{0x9E3779B97F4A7C15ull} + T{1};
+            exps[i] = x;
+        }
+        assert(separate_powmods(bases, exps, m, reps) == joint_powmods(bases, exps, m, reps));
+        auto duration_separate = benchmark<T>(separate_powmods<T>, bases, exps, m, reps);
+        auto duration_joint = benchmark<T>(joint_powmods<T>, bases, exps, m, reps);
+        std::cout << reps << " products of " << terms << " powers mod " << name << " m, separate powmod: "
+                  << duration_separate << ", multi_powmod: " << duration_joint << '\n';
+    }
+
+    void powmod_calc()
+    {
+        const U128 x{11372209130871503813ull, 799616663795765462ull};
+        for (const U128& m : {U128{0xFFFFFFFFFFFFFFC5ull, 0x7FFFFFFFFFFFFFFFull}, U128{0xFFFFFFFFFFFFFFC6ull, 0x7FFFFFFFFFFFFFFFull}}) {
+            assert(naive_powmod_series(x, m) == powmod_series(x, m));
+            auto duration_naive = benchmark<U128>(naive_powmod_series, x, m);
+            auto duration_powmod = benchmark<U128>(powmod_series, x, m);
+            std::cout << "100 powers mod " << ((m.low() & 1ull) ? "odd" : "even") << " m with 128-bit exponents, mult_mod: "
+                      << duration_naive << ", powmod: " << duration_powmod << '\n';
+        }
+        powmod_ubig_calc<U256>("U256");
+        powmod_ubig_calc<U1024>("U1024");
+        powmod_ubig_calc<U4096>("U4096");
+        fixed_base_calc<U128>("U128", U128::max() - U128{158});
+        fixed_base_calc<U256>("U256", U256::max().divrem_u64(3).first | U256{1});
+        fixed_base_calc<U2048>("U2048", U2048::max().divrem_u64(3).first | U2048{1});
+        multi_powmod_calc<U128>("U128", U128::max() - U128{158}, 2, 100);
+        multi_powmod_calc<U128>("U128", U128::max() - U128{158}, 256, 1);
+        multi_powmod_calc<U256>("U256", U256::max().divrem_u64(3).first | U256{1}, 2, 100);
+        multi_powmod_calc<U256>("U256", U256::max().divrem_u64(3).first | U256{1}, 256, 1);
+        multi_powmod_calc<U2048>("U2048", U2048::max().divrem_u64(3).first | U2048{1}, 2, 1);
+    }
+
+    // Цепочка возведений в квадрат с расширением; старшая половина подмешивается в младшую.
+    template <typename T, bool Fast>
+    T square_chain(const typename T::value_type& x) {
+        typename T::value_type y = x;
+        for (int i = 0; i < CHAIN_LENGTH; ++i) {
+            const T z = Fast ? T::square_ext(y) : T::square_ext_basecase(y);
+            y = z.low() ^ z.high();
+        }
+        return T{y};
+    }
+
+    template <typename T>
+    void square_chain_calc(const char* name) {
+        const auto x = T::value_type::max() >> 3;
+        assert((square_chain<T, true>(x) == square_chain<T, false>(x)));
+        auto duration_basecase = benchmark<T>(square_chain<T, false>, x);
+        auto duration_fast = benchmark<T>(square_chain<T, true>, x);
+        std::cout << "Chain of " << CHAIN_LENGTH << " " << name << " squares, schoolbook: " << duration_basecase
+                  << ", square_ext: " << duration_fast << '\n';
+    }
+
+    using FlatMult = void (*)(limbs::u64*, const limbs::u64*, const limbs::u64*, size_t);
+
+    void mul_schoolbook(limbs::u64* r, const limbs::u64* a, const limbs::u64* b, size_t n) {
+        limbs::mul_basecase(r, a, n, b, n);
+    }
+
+    // Серия произведений n-словных чисел; возвращается младшее слово, чтобы результат не был выброшен.
+    uint64_t flat_mult_series(FlatMult mul, const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+        std::vector<uint64_t> r(2 * a.size());
+        for (int i = 0; i < 10; ++i)
+            mul(r.data(), a.data(), b.data(), a.size());
+        return r[0];
+    }
+
+    void mul_ntt(limbs::u64* r, const limbs::u64* a, const limbs::u64* b, size_t n) {
+        ntt_multiply(r, a, n, b, n);
+    }
+
+    // Точка перехода между методами умножения: школьный, Карацуба, Toom-3 (рекурсия внутри - через limbs::mul_n).
+    void flat_mult_calc() {
+        for (size_t n : {16, 32, 96, 192, 384, 768}) {
+            std::vector<uint64_t> a(n), b(n);
+            for (size_t i = 0; i < n; ++i) {
+                a[i] = 0x9E3779B97F4A7C15ull * (i + 1);
+                b[i] = ~a[i] ^ (a[i] >> 7);
+            }
+            auto duration_basecase = benchmark<uint64_t>(flat_mult_series, mul_schoolbook, a, b);
+            auto duration_karatsuba = benchmark<uint64_t>(flat_mult_series, static_cast<FlatMult>(limbs::mul_karatsuba), a, b);
+            auto duration_toom3 = benchmark<uint64_t>(flat_mult_series, static_cast<FlatMult>(limbs::mul_toom3), a, b);
+            std::cout << "10 products of " << n << "-limb numbers, schoolbook: " << duration_basecase
+                      << ", Karatsuba: " << duration_karatsuba << ", Toom-3: " << duration_toom3 << '\n';
+        }
+        for (size_t n : {512, 1024, 2048, 4096}) {
+            std::vector<uint64_t> a(n), b(n);
+            for (size_t i = 0; i < n; ++i) {
+                a[i] = 0x9E3779B97F4A7C15ull * (i + 1);
+                b[i] = ~a[i] ^ (a[i] >> 7);
+            }
+            auto duration_mul_n = benchmark<uint64_t>(flat_mult_series, static_cast<FlatMult>(limbs::mul_n), a, b);
+            auto duration_ntt = benchmark<uint64_t>(flat_mult_series, mul_ntt, a, b);
+            std::cout << "10 products of " << n << "-limb numbers, mul_n: " << duration_mul_n
+                      << ", NTT: " << duration_ntt << '\n';
+        }
+    }
+
+    void mul_schoolbook_generic(limbs::u64* r, const limbs::u64* a, const limbs::u64* b, size_t n) {
+        r[n] = limbs::mul_1(r, a, n, b[0]);
+        for (size_t j = 1; j < n; ++j)
+            r[n + j] = limbs::addmul_1_generic(r + j, a, n, b[j]);
+    }
+
+    // Школьное умножение: переносимая строка r += a * k против ядра MULX/ADCX/ADOX (если процессор его поддерживает).
+    void carry_kernels_calc() {
+        for (size_t n : {8, 16, 32, 64}) {
+            std::vector<uint64_t> a(n), b(n);
+            for (size_t i = 0; i < n; ++i) {
+                a[i] = 0x9E3779B97F4A7C15ull * (i + 1);
+                b[i] = ~a[i] ^ (a[i] >> 7);
+            }
+            assert(flat_mult_series(mul_schoolbook_generic, a, b) == flat_mult_series(mul_schoolbook, a, b));
+            auto duration_generic = benchmark<uint64_t>(flat_mult_series, mul_schoolbook_generic, a, b);
+            auto duration_dispatch = benchmark<uint64_t>(flat_mult_series, mul_schoolbook, a, b);
+            std::cout << "10 schoolbook products of " << n << "-limb numbers, generic: " << duration_generic
+                      << ", dispatched: " << duration_dispatch << '\n';
+        }
+    }
+
+    // Цепочка возведений в квадрат по модулю 2^N: UBig::square() против произведения двух разных объектов.
+    template <typename T, bool Square>
+    T truncated_square_chain(const T& x) {
+        T y = x;
+        for (int i = 0; i < CHAIN_LENGTH; ++i) {
+            const T copy = y;
+            y = (Square ? y.square() : y * copy) + T{1};
+        }
+        return y;
+    }
+
+    template <typename T>
+    void truncated_square_calc(const char* name) {
+        const T x = T::max().divrem_u64(7).first;
+        assert((truncated_square_chain<T, true>(x) == truncated_square_chain<T, false>(x)));
+        auto duration_mult = benchmark<T>(truncated_square_chain<T, false>, x);
+        auto duration_square = benchmark<T>(truncated_square_chain<T, true>, x);
+        std::cout << "Chain of " << CHAIN_LENGTH << " " << name << " squares mod 2^N, operator*: " << duration_mult
+                  << ", square(): " << duration_square << '\n';
+    }
+
+    // Старшая половина произведения: полное произведение с расширением против UBig::mulhi и UBig::mul_hi_approx.
+    template <typename T, int Kind>
+    T mulhi_chain(const T& x) {
+        T y = x;
+        for (int i = 0; i < CHAIN_LENGTH; ++i) {
+            if constexpr (Kind == 0)
+                y = UBig<T>::mult_ext(y, x).high();
+            else if constexpr (Kind == 1)
+                y = T::mulhi(y, x);
+            else
+                y = T::mul_hi_approx(y, x);
+            y = ~y;
+        }
+        return y;
+    }
+
+    template <typename T>
+    void mulhi_calc(const char* name) {
+        const T x = T::max().divrem_u64(7).first;
+        assert((mulhi_chain<T, 0>(x) == mulhi_chain<T, 1>(x)));
+        auto duration_full = benchmark<T>(mulhi_chain<T, 0>, x);
+        auto duration_exact = benchmark<T>(mulhi_chain<T, 1>, x);
+        auto duration_approx = benchmark<T>(mulhi_chain<T, 2>, x);
+        std::cout << "Chain of " << CHAIN_LENGTH << " " << name << " high halves, mult_ext: " << duration_full
+                  << ", mulhi: " << duration_exact << ", mul_hi_approx: " << duration_approx << '\n';
+    }
+
+    // Произведение N-битного числа на N/2-битное: расширение множителя до N бит и mult_ext против UBig::mul_wide.
+    template <typename T, bool Wide>
+    T mul_wide_chain(const T& x, const typename T::value_type& y) {
+        T z = x;
+        for (int i = 0; i < CHAIN_LENGTH; ++i) {
+            if constexpr (Wide)
+                z = T::mul_wide(z, y).first;
+            else
+                z = UBig<T>::mult_ext(z, T{y}).low();
+            z.add_u64(i);
+        }
+        return z;
+    }
+
+    template <typename T>
+    void mul_wide_calc(const char* name) {
+        using H = typename T::value_type;
+        const T x = T::max().divrem_u64(7).first;
+        const H y = ~H{12345} >> 1;
+        assert((mul_wide_chain<T, true>(x, y) == mul_wide_chain<T, false>(x, y)));
+        auto duration_ext = benchmark<T>(mul_wide_chain<T, false>, x, y);
+        auto duration_wide = benchmark<T>(mul_wide_chain<T, true>, x, y);
+        std::cout << "Chain of " << CHAIN_LENGTH << " " << name << " x half products, mult_ext: " << duration_ext
+                  << ", mul_wide: " << duration_wide << '\n';
+    }
+
+    void multiplication_calc()
+    {
+        square_chain_calc<U2048>("U2048");
+        square_chain_calc<U4096>("U4096");
+        flat_mult_calc();
+        carry_kernels_calc();
+        truncated_square_calc<U512>("U512");
+        truncated_square_calc<U2048>("U2048");
+        truncated_square_calc<U8192>("U8192");
+        mulhi_calc<U256>("U256");
+        mulhi_calc<U1024>("U1024");
+        mulhi_calc<U4096>("U4096");
+        mul_wide_calc<U256>("U256");
+        mul_wide_calc<U1024>("U1024");
+        mul_wide_calc<U4096>("U4096");
+    }
+
+    // Деление 128/64 инструкцией divq - аппаратный эталон; limbs::div_2by1 с __int128 вызывает программную
+    // __udivmodti4 (128/128), поэтому для сравнения не годится. Требуется u1 < v.
+    inline uint64_t div_2by1_hw(uint64_t u1, uint64_t u0, uint64_t v, uint64_t* rem) {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+        uint64_t q;
+        __asm__("divq %[v]" : "=a"(q), "=d"(*rem) : [v] "r"(v), "a"(u0), "d"(u1) : "cc");
+        return q;
+#else
+        return limbs::div_2by1(u1, u0, v, rem);
+#endif
+    }
+
+    enum class WordDivision { Hardware, Generic, Reciprocal };
+
+    // Деление длинного числа на слово: divq на каждое слово, limbs::div_2by1 и деление по обратной величине.
+    uint64_t divide_by_word_series(WordDivision method, const std::vector<uint64_t>& a) {
+        std::vector<uint64_t> q(a.size());
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < 100; ++i) {
+            const uint64_t d = detail::POW10[19] + i;
+            if (method == WordDivision::Reciprocal) {
+                acc += limbs::divrem_u64(q.data(), a.data(), a.size(), d);
+            } else {
+                uint64_t r = 0;
+                for (size_t j = a.size(); j-- > 0;)
+                    q[j] = method == WordDivision::Hardware ? div_2by1_hw(r, a[j], d, &r) : limbs::div_2by1(r, a[j], d, &r);
+                acc += r;
+            }
+        }
+        return acc;
+    }
+
+    void division_calc()
+    {
+        std::vector<uint64_t> a(1024);
+        for (size_t i = 0; i < a.size(); ++i)
+            a[i] = 0x9E3779B97F4A7C15ull * (i + 1);
+        assert(divide_by_word_series(WordDivision::Reciprocal, a) == divide_by_word_series(WordDivision::Hardware, a));
+        assert(divide_by_word_series(WordDivision::Generic, a) == divide_by_word_series(WordDivision::Hardware, a));
+        auto duration_hw = benchmark<uint64_t>(divide_by_word_series, WordDivision::Hardware, a);
+        auto duration_generic = benchmark<uint64_t>(divide_by_word_series, WordDivision::Generic, a);
+        auto duration_preinv = benchmark<uint64_t>(divide_by_word_series, WordDivision::Reciprocal, a);
+        std::cout << "100 divisions of a " << a.size() << "-limb number by a word, divq: " << duration_hw
+                  << ", div_2by1: " << duration_generic << ", reciprocal: " << duration_preinv << '\n';
+    }
+
+    // Иерархические (рекурсивные по половинкам) сложение, вычитание и сдвиги - эталон для "плоских" циклов UBig.
+    template <typename T>
+    void add_hierarchical(T& a, const T& b) {
+        if constexpr (std::is_same_v<T, U128>) {
+            a += b;
+        } else {
+            const auto old = a.low();
+            add_hierarchical(a.low(), b.low());
+            if (a.low() < old)
+                ++a.high();
+            add_hierarchical(a.high(), b.high());
+        }
+    }
+
+    template <typename T>
+    void sub_hierarchical(T& a, const T& b) {
+        if constexpr (std::is_same_v<T, U128>) {
+            a -= b;
+        } else {
+            if (a.low() < b.low())
+                --a.high();
+            sub_hierarchical(a.low(), b.low());
+            sub_hierarchical(a.high(), b.high());
+        }
+    }
+
+    template <typename T>
+    T shr_hierarchical(const T& x, uint32_t s);
+
+    template <typename T>
+    T shl_hierarchical(const T& x, uint32_t s) {
+        if constexpr (std::is_same_v<T, U128>) {
+            return x << s;
+        } else {
+            using H = typename T::value_type;
+            if (s >= T::WIDTH)
+                return T{0};
+            if (s >= T::HALF_WIDTH)
+                return T{H{0}, shl_hierarchical(x.low(), s - T::HALF_WIDTH)};
+            if (s == 0)
+                return x;
+            return T{shl_hierarchical(x.low(), s),
+                     shl_hierarchical(x.high(), s) | shr_hierarchical(x.low(), T::HALF_WIDTH - s)};
+        }
+    }
+
+    template <typename T>
+    T shr_hierarchical(const T& x, uint32_t s) {
+        if constexpr (std::is_same_v<T, U128>) {
+            return x >> s;
+        } else {
+            using H = typename T::value_type;
+            if (s >= T::WIDTH)
+                return T{0};
+            if (s >= T::HALF_WIDTH)
+                return T{shr_hierarchical(x.high(), s - T::HALF_WIDTH), H{0}};
+            if (s == 0)
+                return x;
+            return T{shr_hierarchical(x.low(), s) | shl_hierarchical(x.high(), T::HALF_WIDTH - s),
+                     shr_hierarchical(x.high(), s)};
+        }
+    }
+
+    constexpr int FLAT_OPS_COUNT = 10000;
+
+    template <typename T, bool Flat>
+    T add_sub_series(const std::vector<T>& v) {
+        T acc = v[0];
+        for (int i = 0; i < FLAT_OPS_COUNT; ++i) {
+            if constexpr (Flat) {
+                acc += v[i % v.size()];
+                acc -= v[(i + 1) % v.size()];
+            } else {
+                add_hierarchical(acc, v[i % v.size()]);
+                sub_hierarchical(acc, v[(i + 1) % v.size()]);
+            }
+        }
+        return acc;
+    }
+
+    template <typename T, bool Flat>
+    T shift_series(const std::vector<T>& v) {
+        T acc{0};
+        for (int i = 0; i < FLAT_OPS_COUNT; ++i) {
+            const uint32_t s = static_cast<uint32_t>(i * 37) % T::WIDTH;
+            const T& x = v[i % v.size()];
+            acc ^= Flat ? (x << s) ^ (x >> s) : shl_hierarchical(x, s) ^ shr_hierarchical(x, s);
+        }
+        return acc;
+    }
+
+    // Сравнение чисел, совпадающих во всех словах, кроме младшего: худший случай для обоих способов.
+    template <typename T, bool Flat>
+    uint64_t compare_series(const std::vector<T>& v) {
+        uint64_t count = 0;
+        for (int i = 0; i < FLAT_OPS_COUNT; ++i) {
+            const T& a = v[i % v.size()];
+            T b = a;
+            b.limbs()[0] ^= 1;
+            count += Flat ? limbs::cmp_n(a.limbs().data(), b.limbs().data(), T::LIMBS) < 0 : a < b;
+        }
+        return count;
+    }
+
+    // Умножение в поле по модулю 2^k - c: деление (mult_mod), Монтгомери и сворачивание PseudoMersenneField.
+    template <typename F, int Method>
+    typename F::value_type field_mul_chain(const typename F::value_type& x, const typename F::value_type& y) {
+        using T = typename F::value_type;
+        const T p = F::modulus();
+        const MontgomeryContext<T> ctx{p};
+        T z = Method == 1 ? ctx.to_mont(x) : x;
+        const T w = Method == 1 ? ctx.to_mont(y) : y;
+        for (int i = 0; i < CHAIN_LENGTH; ++i) {
+            if constexpr (Method == 0) {
+                if constexpr (std::is_same_v<T, U128>)
+                    z = u128_utils::mult_mod(z, w, p);
+                else
+                    UBig<T>::template divide<false, true>(UBig<T>::mult_ext(T{z}, w), p, &z);
+            } else if constexpr (Method == 1)
+                z = ctx.mul(z, w);
+            else
+                z = F::mul(z, w);
+        }
+        return Method == 1 ? ctx.from_mont(z) : z;
+    }
+
+    template <uint32_t Bits, uint64_t C>
+    void pseudo_mersenne_calc(const char* name) {
+        using F = PseudoMersenneField<Bits, C>;
+        using T = typename F::value_type;
+        const T x = F::reduce(T::max() - T{0x9E3779B97F4A7C15ull});
+        const T y = F::reduce(T::max() >> 3);
+        assert((field_mul_chain<F, 0>(x, y) == field_mul_chain<F, 2>(x, y)));
+        assert((field_mul_chain<F, 1>(x, y) == field_mul_chain<F, 2>(x, y)));
+        auto duration_div = benchmark<T>(field_mul_chain<F, 0>, x, y);
+        auto duration_mont = benchmark<T>(field_mul_chain<F, 1>, x, y);
+        auto duration_field = benchmark<T>(field_mul_chain<F, 2>, x, y);
+        std::cout << CHAIN_LENGTH << " multiplications mod " << name << ", mult_mod: " << duration_div
+                  << ", Montgomery: " << duration_mont << ", PseudoMersenneField: " << duration_field << '\n';
+    }
+
+    void pseudo_mersenne_calc()
+    {
+        pseudo_mersenne_calc<127, 1>("2^127 - 1");
+        pseudo_mersenne_calc<255, 19>("2^255 - 19");
+        pseudo_mersenne_calc<521, 1>("2^521 - 1");
+    }
+
+
+    template <typename T>
+    void flat_ops_calc(const char* name) {
+        std::vector<T> v(16);
+        uint64_t seed = 1;
+        for (auto& x : v)
+            for (auto& limb : x.limbs())
+                limb = seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        assert((add_sub_series<T, true>(v) == add_sub_series<T, false>(v)));
+        assert((shift_series<T, true>(v) == shift_series<T, false>(v)));
+        assert((compare_series<T, true>(v) == compare_series<T, false>(v)));
+        auto add_hier = benchmark<T>(add_sub_series<T, false>, v);
+        auto add_flat = benchmark<T>(add_sub_series<T, true>, v);
+        auto shift_hier = benchmark<T>(shift_series<T, false>, v);
+        auto shift_flat = benchmark<T>(shift_series<T, true>, v);
+        auto cmp_hier = benchmark<uint64_t>(compare_series<T, false>, v);
+        auto cmp_flat = benchmark<uint64_t>(compare_series<T, true>, v);
+        std::cout << name << " x" << FLAT_OPS_COUNT << ", hierarchical/flat: add+sub " << add_hier << "/" << add_flat
+                  << ", shifts " << shift_hier << "/" << shift_flat << ", compare " << cmp_hier << "/" << cmp_flat << '\n';
+    }
+
+    void flat_ops_calc()
+    {
+        flat_ops_calc<U256>("U256");
+        flat_ops_calc<U512>("U512");
+        flat_ops_calc<U1024>("U1024");
+        flat_ops_calc<U2048>("U2048");
+        flat_ops_calc<U4096>("U4096");
+        flat_ops_calc<U8192>("U8192");
     }
-}
\ No newline at end of file
+}
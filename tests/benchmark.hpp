@@ -19,4 +19,14 @@ long long benchmark(Func func, Args&&... args) {
 
 void modulo_poly_calc();
 
+void powmod_calc();
+
+void pseudo_mersenne_calc();
+
+void multiplication_calc();
+
+void division_calc();
+
+void flat_ops_calc();
+
 }
\ No newline at end of file
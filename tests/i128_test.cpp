@@ -47,6 +47,36 @@ namespace tests_i128
         }
     }
 
+    void to_chars_test()
+    {
+        auto check = [](const I128 &x, std::string_view expected)
+        {
+            char buf[40];
+            const auto [ptr, ec] = to_chars(buf, buf + sizeof(buf), x);
+            assert(ec == std::errc{});
+            assert(std::string_view(buf, ptr) == expected);
+            assert(to_chars(buf, buf + expected.size() - 1, x).ec == std::errc::value_too_large);
+            I128 y;
+            const auto [end, ec2] = from_chars(expected.data(), expected.data() + expected.size(), y);
+            assert(ec2 == std::errc{});
+            assert(end == expected.data() + expected.size());
+            assert(y.toString() == expected);
+        };
+        check(I128{0}, "0");
+        check(-I128{0}, "0");
+        check(I128{42}, "42");
+        check(-I128{42}, "-42");
+        check(-I128{U128::max()}, "-340282366920938463463374607431768211455");
+        check(I128{U128{1}, Sign{false}, Singular{true}}, "inf");
+        check(I128{U128{1}, Sign{false}, Singular{false, true}}, "nan");
+        {
+            const std::string_view s = "-";
+            I128 y;
+            const auto [end, ec] = from_chars(s.data(), s.data() + s.size(), y);
+            assert(ec == std::errc::invalid_argument && end == s.data());
+        }
+    }
+
     void cmp_operator_test()
     {
         {
@@ -11,6 +11,8 @@ namespace tests_i128
 
     void string_value_test();
 
+    void to_chars_test();
+
     void cmp_operator_test();
 
     void addition_test();
@@ -5,6 +5,8 @@
 #include "../defines.h"
 #include "../u128.hpp"
 #include "../u128_utils.hpp"
+#include "../montgomery.hpp"
+#include "../barrett.hpp"
 
 using namespace bignum::u128;
 using u64 = uint64_t;
@@ -161,6 +163,51 @@ namespace tests_u128
         printf("--- Тестирование завершено ---\n");
     }
 
+    void to_chars_test()
+    {
+        auto check = [](const U128 &x, std::string_view expected)
+        {
+            char buf[39];
+            const auto [ptr, ec] = to_chars(buf, buf + sizeof(buf), x);
+            assert(ec == std::errc{});
+            assert(std::string_view(buf, ptr) == expected);
+            // Буфер без места под последнюю цифру.
+            const auto small = to_chars(buf, buf + expected.size() - 1, x);
+            assert(small.ec == std::errc::value_too_large);
+            U128 y;
+            const auto [end, ec2] = from_chars(expected.data(), expected.data() + expected.size(), y);
+            assert(ec2 == std::errc{});
+            assert(end == expected.data() + expected.size());
+            assert(y == x);
+        };
+        check(U128{0}, "0");
+        check(U128{7}, "7");
+        check(U128{10000000000000000000ull}, "10000000000000000000");
+        check(U128{~0ull}, "18446744073709551615");
+        check(U128{0, 1}, "18446744073709551616");
+        check(U128{1, 1}, "18446744073709551617");
+        check("100000000000000000000000000000000000000"_u128, "100000000000000000000000000000000000000");
+        check(U128::max(), "340282366920938463463374607431768211455");
+        {
+            const std::string_view s = "12345xyz";
+            U128 y;
+            const auto [end, ec] = from_chars(s.data(), s.data() + s.size(), y);
+            assert(ec == std::errc{} && y == U128{12345} && *end == 'x');
+        }
+        {
+            const std::string_view s = "+1";
+            U128 y{5};
+            const auto [end, ec] = from_chars(s.data(), s.data() + s.size(), y);
+            assert(ec == std::errc::invalid_argument && end == s.data() && y == U128{5});
+        }
+        {
+            const std::string_view s = "340282366920938463463374607431768211456";
+            U128 y{5};
+            const auto [end, ec] = from_chars(s.data(), s.data() + s.size(), y);
+            assert(ec == std::errc::result_out_of_range && end == s.data() + s.size() && y == U128{5});
+        }
+    }
+
 void stressTestU128() 
 {
     std::random_device rd;
@@ -758,6 +805,97 @@ void stressTestU128()
         }
     }
 
+    void montgomery_test()
+    {
+        using namespace u128_utils;
+        const U128 moduli[] = {U128{1}, U128{3}, U128{1857756895516871747ull},
+                               U128{17, 13}, U128{0xFFFFFFFFFFFFFFC5ull, 0xFFFFFFFFFFFFFFFFull}, U128::max()};
+        for (const auto &m : moduli)
+        {
+            const bignum::MontgomeryContext<U128> ctx{m};
+            for (int i = 0; i < 1000; ++i)
+            {
+                const U128 x{roll_u64(1, 0), roll_u64(1, 0)};
+                const U128 y{roll_u64(1, 0), roll_u64(1, 0)};
+                const U128 xm = ctx.to_mont(x);
+                const U128 ym = ctx.to_mont(y);
+                assert(ctx.from_mont(xm) == x % m);
+                assert(ctx.from_mont(ctx.mul(xm, ym)) == mult_mod(x, y, m));
+                assert(ctx.from_mont(ctx.sqr(xm)) == mult_mod(x, x, m));
+            }
+        }
+        {
+            // Малая теорема Ферма: 3^(p-1) = 1 mod p.
+            const U128 p = "170141183460469231731687303715884105727"_u128; // 2^127 - 1
+            const bignum::MontgomeryContext<U128> ctx{p};
+            assert(ctx.from_mont(ctx.pow(ctx.to_mont(3), p - 1)) == U128{1});
+            assert(ctx.from_mont(ctx.pow(ctx.to_mont(3), 0)) == U128{1});
+            assert(ctx.from_mont(ctx.pow(ctx.to_mont(3), 5)) == U128{243});
+        }
+    }
+
+    void barrett_test()
+    {
+        using namespace u128_utils;
+        using U256 = bignum::UBig<U128>;
+        const U128 moduli[] = {U128{1}, U128{2}, U128{10}, U128{1857756895516871747ull}, U128{0, 1},
+                               U128{17, 13}, U128{0, 0x8000000000000000ull}, U128::max()};
+        for (const auto &m : moduli)
+        {
+            const bignum::BarrettReducer reducer{m};
+            for (int i = 0; i < 1000; ++i)
+            {
+                const U128 x{roll_u64(1, 0), roll_u64(1, 0)};
+                const U128 y{roll_u64(1, 0), roll_u64(1, 0)};
+                assert(reducer.reduce(x) == x % m);
+                assert(reducer.mul(x, y) == mult_mod(x, y, m));
+                assert(reducer.reduce(U256::mult_ext(x, y)) == mult_mod(x, y, m));
+            }
+            assert(reducer.reduce(U256::max()) == (U256::max() / m).second);
+        }
+    }
+
+    void powmod_test()
+    {
+        using namespace u128_utils;
+        // Эталон: бинарный метод "справа налево" через mult_mod.
+        const auto naive_powmod = [](U128 x, U128 e, const U128 &m)
+        {
+            U128 r = U128{1} % m;
+            x %= m;
+            for (; e != 0; e >>= 1)
+            {
+                if ((e.low() & 1ull) != 0)
+                    r = mult_mod(r, x, m);
+                x = mult_mod(x, x, m);
+            }
+            return r;
+        };
+        const U128 moduli[] = {U128{1}, U128{2}, U128{3}, U128{10}, U128{1857756895516871747ull}, U128{0, 1},
+                               U128{17, 13}, U128{18, 13}, U128{0, 0x8000000000000000ull}, U128::max(), U128::max() - 1};
+        for (const auto &m : moduli)
+        {
+            for (int i = 0; i < 200; ++i)
+            {
+                const U128 x{roll_u64(1, 0), roll_u64(1, 0)};
+                // Показатели всех длин: от нескольких бит (окно 1) до 128 бит (окно 4).
+                const U128 e = U128{roll_u64(1, 0), roll_u64(1, 0)} >> (i % 128);
+                assert(powmod(x, e, m) == naive_powmod(x, e, m));
+            }
+            assert(powmod(U128{5}, U128{0}, m) == U128{1} % m);
+            assert(powmod(U128{0}, U128{7}, m) == U128{0});
+        }
+        {
+            // Малая теорема Ферма: a^(p-1) = 1 mod p.
+            const U128 p = "170141183460469231731687303715884105727"_u128; // 2^127 - 1
+            assert(powmod(U128{3}, p - 1, p) == U128{1});
+            assert(powmod(U128{123456789, 987654321}, p - 1, p) == U128{1});
+            assert(powmod(U128{2}, U128{127}, p) == U128{1});
+            // Четный модуль 2^64: сверка со степенью по модулю 2^128.
+            assert((powmod(U128{3}, U128{100}, U128{0, 1}) == int_power_fast(U128{3}, 100) % U128{0, 1}));
+        }
+    }
+
     void modular_inverse_test()
     {
         using namespace u128_utils;
@@ -13,6 +13,8 @@ namespace tests_u128
 
     void testU128ToString();
 
+    void to_chars_test();
+
     void stressTestU128();
 
     void cmp_operator_test();
@@ -47,6 +49,12 @@ namespace tests_u128
 
     void mult_mod_test();
 
+    void montgomery_test();
+
+    void barrett_test();
+
+    void powmod_test();
+
     void modular_inverse_test();
 
     void quadratic_residue_test();
@@ -1,14 +1,27 @@
 #include "ubig_test.hpp"
 #include "../ubig.hpp"
 #include "../u128.hpp"
+#include "../divider.hpp"
+#include "../ntt.hpp"
+#include "../ulow.hpp"
+#include "../uint.hpp"
+#include "../u128_utils.hpp"
+#include "../montgomery.hpp"
+#include "../fixed_base_pow.hpp"
+#include "../pseudo_mersenne.hpp"
 #include <cassert>
 #include <iostream>
 #include <vector>
+#include <memory>
+#include <algorithm>
 
 using namespace bignum;
 using U128 = bignum::u128::U128;
 using U256 = UBig<U128>;
 using U512 = UBig<U256>;
+using U1024 = UBig<U512>;
+using U2048 = UBig<U1024>;
+using U4096 = UBig<U2048>;
 
 #include <random>
 
@@ -225,4 +238,912 @@ void stress_test_u256(int iterations)
 }
 
 
-}
\ No newline at end of file
+void divider_test()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+
+    std::cout << "Running Divider tests..." << std::endl;
+
+    // U128: сверка с обычным делением.
+    for (int i = 0; i < 2000; ++i) {
+        U128 d = random_u128(gen) >> (gen() % 128);
+        if (d == U128{0}) d = U128{1};
+        const Divider<U128> divider{d};
+        for (int j = 0; j < 16; ++j) {
+            const U128 n = random_u128(gen);
+            U128 r;
+            const U128 q = U128::divide<true, true>(n, d, &r);
+            assert(divider.quot(n) == q);
+            assert(divider.divrem(n) == std::make_pair(q, r));
+        }
+        assert(divider.rem(U128::max()) == U128::max() % d);
+    }
+
+    // U256: сверка с обычным делением.
+    for (int i = 0; i < 2000; ++i) {
+        U256 d = random_u256(gen) >> (gen() % 256);
+        if (d == U256{0}) d = U256{3};
+        const Divider<U256> divider{d};
+        const U256 n = random_u256(gen);
+        const auto [q, r] = divider.divrem(n);
+        assert(r < d);
+        assert(q * d + r == n);
+        assert(divider.divrem(U256::max()) == U256::max() / d);
+    }
+
+    // U512: делители различной разрядности, включая степени двойки.
+    for (int i = 0; i < 500; ++i) {
+        U512 d = U512{random_u256(gen), random_u256(gen)} >> (gen() % 512);
+        if (i % 50 == 0) d = U512{1} << (gen() % 512);
+        if (d == U512{0}) d = U512{7};
+        const Divider<U512> divider{d};
+        const U512 n{random_u256(gen), random_u256(gen)};
+        const auto [q, r] = divider.divrem(n);
+        assert(r < d);
+        assert(q * d + r == n);
+    }
+    std::cout << "Divider tests passed!" << std::endl;
+}
+
+void from_chars_test()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+
+    std::cout << "Running decimal parser tests..." << std::endl;
+
+    for (int i = 0; i < 2000; ++i) {
+        const U512 x = U512{random_u256(gen), random_u256(gen)} >> (gen() % 512);
+        const std::string s = x.toString();
+        assert(U512::fromString(s) == x);
+        assert(U512::fromString(" +" + s + "x123") == x);
+        U512 y;
+        const std::string t = s + "_tail";
+        const auto [end, ec] = from_chars(t.data(), t.data() + t.size(), y);
+        assert(ec == std::errc{} && y == x && *end == '_');
+
+        const U128 z = x.low().low();
+        const std::string zs = z.toString() + "7x";
+        assert(U128::fromString(zs) == z * U128{10} + U128{7});
+    }
+    {
+        // Первая не цифра внутри блока из 16 цифр.
+        const std::string s = "1234567890123x5678901234567890";
+        U256 y;
+        const auto [end, ec] = from_chars(s.data(), s.data() + s.size(), y);
+        assert(ec == std::errc{} && y == U256{1234567890123ull} && end == s.data() + 13);
+    }
+    {
+        const std::string s = "x1";
+        U256 y{5};
+        const auto [end, ec] = from_chars(s.data(), s.data() + s.size(), y);
+        assert(ec == std::errc::invalid_argument && end == s.data() && y == U256{5});
+    }
+    {
+        // 2^256 - 1 разбирается, 2^256 - переполнение.
+        const std::string max_str = U256::max().toString();
+        U256 y;
+        assert(from_chars(max_str.data(), max_str.data() + max_str.size(), y).ec == std::errc{});
+        assert(y == U256::max());
+        const std::string over = "115792089237316195423570985008687907853269984665640564039457584007913129639936";
+        const auto [end, ec] = from_chars(over.data(), over.data() + over.size(), y);
+        assert(ec == std::errc::result_out_of_range && end == over.data() + over.size() && y == U256::max());
+        const std::string longer = max_str + "0";
+        assert(from_chars(longer.data(), longer.data() + longer.size(), y).ec == std::errc::result_out_of_range);
+    }
+    std::cout << "Decimal parser tests passed!" << std::endl;
+}
+
+void to_string_test()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+
+    std::cout << "Running toString tests..." << std::endl;
+    {
+        // Степень десяти проверяет дополнение нулями всех частей.
+        U4096 x{1};
+        for (int i = 0; i < 1200; ++i)
+            x = x * U4096{10};
+        assert(x.toString() == "1" + std::string(1200, '0'));
+        assert(U4096::fromString("1" + std::string(1200, '0')) == x);
+        x = x + U4096{7};
+        assert(x.toString() == "1" + std::string(1199, '0') + "7");
+    }
+    {
+        const std::string max_str = U4096::max().toString();
+        assert(max_str.size() == 1234);
+        assert(max_str.substr(0, 20) == "10443888814131525066");
+        assert(max_str.substr(max_str.size() - 20) == "04708340403154190335");
+        // Длинная строка разбирается рекурсивно, переполнение обнаруживается.
+        U4096 y;
+        const auto [end, ec] = from_chars(max_str.data(), max_str.data() + max_str.size(), y);
+        assert(ec == std::errc{} && end == max_str.data() + max_str.size() && y == U4096::max());
+        const std::string over = max_str + "0";
+        assert(from_chars(over.data(), over.data() + over.size(), y).ec == std::errc::result_out_of_range);
+        assert(U4096::fromString(over + "z") == U4096::max() * U4096{10});
+    }
+    for (int i = 0; i < 100; ++i) {
+        std::array<uint64_t, U2048::LIMBS> limbs;
+        for (auto& limb : limbs)
+            limb = gen();
+        const U2048 x = U2048::from_limbs(limbs) >> (gen() % 2048);
+        assert(U2048::fromString(x.toString()) == x);
+    }
+    std::cout << "toString tests passed!" << std::endl;
+}
+
+template <typename T>
+T random_ubig(std::mt19937_64& gen)
+{
+    std::array<uint64_t, T::LIMBS> limbs;
+    for (auto& limb : limbs)
+        limb = gen();
+    return T::from_limbs(limbs) >> (gen() % T::WIDTH);
+}
+
+// Сравнение mult_ext и square_ext со школьным умножением "плоских" массивов.
+template <typename T>
+void check_mult_ext(std::mt19937_64& gen, int iterations)
+{
+    using H = typename T::value_type;
+    using Q = typename H::value_type;
+    auto check = [](const H& x, const H& y) {
+        const auto xl = x.to_limbs();
+        const auto yl = y.to_limbs();
+        std::array<uint64_t, T::LIMBS> expected;
+        limbs::mul_basecase(expected.data(), xl.data(), xl.size(), yl.data(), yl.size());
+        assert(T::mult_ext(x, y).to_limbs() == expected);
+        assert(T::mult_ext_basecase(x, y).to_limbs() == expected);
+        if (x == y)
+            assert(T::square_ext(x).to_limbs() == expected);
+    };
+    check(H::max(), H::max());
+    check(H::max(), H{1});
+    check(H{0}, H::max());
+    check(H{Q{0}, Q::max()}, H{Q::max(), Q{0}});
+    for (int i = 0; i < iterations; ++i) {
+        const H x = random_ubig<H>(gen);
+        check(x, random_ubig<H>(gen));
+        check(x, x);
+    }
+}
+
+void multiplication_test()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+
+    std::cout << "Running multiplication tests..." << std::endl;
+    check_mult_ext<U1024>(gen, 1000);
+    check_mult_ext<U2048>(gen, 300);
+    check_mult_ext<U4096>(gen, 100);
+    // Половинки из 256 и 512 слов: Toom-3 с рекурсией в метод Карацубы.
+    check_mult_ext<UBig<UBig<UBig<U4096>>>>(gen, 10);
+    check_mult_ext<UBig<UBig<UBig<UBig<U4096>>>>>(gen, 5);
+    // Toom-3 сразу за порогом MUL_TOOM3_THRESHOLD (все остатки n mod 3) против школьного умножения.
+    for (size_t n : {limbs::MUL_TOOM3_THRESHOLD, limbs::MUL_TOOM3_THRESHOLD + 1, limbs::MUL_TOOM3_THRESHOLD + 2, size_t{385}}) {
+        std::vector<uint64_t> a(n), b(n), expected(2 * n), r(2 * n);
+        for (int i = 0; i < 3; ++i) {
+            for (auto& limb : a)
+                limb = i == 0 ? ~0ull : gen();
+            for (auto& limb : b)
+                limb = i == 0 ? ~0ull : gen();
+            limbs::mul_basecase(expected.data(), a.data(), n, b.data(), n);
+            limbs::mul_toom3(r.data(), a.data(), b.data(), n);
+            assert(r == expected);
+            limbs::mul_n(r.data(), a.data(), b.data(), n);
+            assert(r == expected);
+        }
+    }
+    // Квадраты limbs::sqr_n (школьный, Карацуба, Toom-3) против школьного умножения.
+    for (size_t n : {1, 2, 3, 7, 39, 40, 41, 63, 64, 65, 100, 191, 192, 257, 600}) {
+        std::vector<uint64_t> a(n), expected(2 * n), r(2 * n);
+        for (int i = 0; i < 3; ++i) {
+            for (auto& limb : a)
+                limb = i == 0 ? ~0ull : gen();
+            limbs::mul_basecase(expected.data(), a.data(), n, a.data(), n);
+            limbs::sqr_basecase(r.data(), a.data(), n);
+            assert(r == expected);
+            limbs::sqr_n(r.data(), a.data(), n);
+            assert(r == expected);
+        }
+    }
+    std::cout << "Multiplication tests passed!" << std::endl;
+}
+
+void ntt_multiply_test()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+
+    std::cout << "Running NTT multiplication tests..." << std::endl;
+    for (int i = 0; i < 100; ++i) {
+        size_t na = 1 + gen() % 600;
+        size_t nb = 1 + gen() % 600;
+        if (na < nb)
+            std::swap(na, nb);
+        std::vector<uint64_t> a(na), b(nb), expected(na + nb), r(na + nb);
+        // Каждый третий набор - из максимальных слов: наибольшие коэффициенты свертки.
+        for (auto& limb : a)
+            limb = i % 3 == 0 ? ~0ull : gen();
+        for (auto& limb : b)
+            limb = i % 3 == 0 ? ~0ull : gen();
+        limbs::mul(expected.data(), a.data(), na, b.data(), nb);
+        ntt_multiply(r.data(), a.data(), na, b.data(), nb);
+        assert(r == expected);
+        limbs::mul_n(expected.data(), b.data(), b.data(), nb);
+        ntt_multiply(r.data(), b.data(), nb, b.data(), nb);
+        assert(std::equal(expected.begin(), expected.begin() + 2 * nb, r.begin()));
+    }
+    {
+        // Квадрат числа разрядностью 2^18 бит через UBig::square_ext (путь NTT).
+        using U512K = UBig<UBig<UBig<UBig<UBig<UBig<UBig<U4096>>>>>>>;
+        using H = U512K::value_type;
+        static_assert(U512K::WIDTH >= NTT_MULT_THRESHOLD_BITS);
+        // Путь NTT выделяет память и не объявлен noexcept; более узкие произведения - noexcept.
+        static_assert(!noexcept(U512K::square_ext(std::declval<const H&>())) && !noexcept(std::declval<const U512K&>() * std::declval<const U512K&>()));
+        static_assert(noexcept(H::square_ext(std::declval<const H::value_type&>())) && noexcept(std::declval<const H&>() * std::declval<const H&>()));
+        std::vector<uint64_t> x(H::LIMBS), expected(U512K::LIMBS);
+        for (auto& limb : x)
+            limb = gen();
+        limbs::mul_n(expected.data(), x.data(), x.data(), x.size());
+        std::array<uint64_t, H::LIMBS> xl;
+        std::copy(x.begin(), x.end(), xl.begin());
+        const auto square = std::make_unique<U512K>(U512K::square_ext(H::from_limbs(xl)));
+        const auto sl = square->to_limbs();
+        assert(std::equal(sl.begin(), sl.end(), expected.begin()));
+    }
+    std::cout << "NTT multiplication tests passed!" << std::endl;
+}
+
+// Проверка деления n / d и n / ULOW по инвариантам q * d + r = n, r < d.
+template <typename T>
+void check_division(const T& n, const T& d)
+{
+    const auto [q, r] = n / d;
+    assert(r < d);
+    assert(UBig<T>::mult_ext(q, d).high() == T{0});
+    assert(q * d + r == n);
+    // Варианты с вычислением только частного или только остатка.
+    T r_only;
+    assert((T::template divide<true, false>(n, d, nullptr) == q));
+    assert((T::template divide<false, true>(n, d, &r_only) == T{0} && r_only == r));
+    assert(n % d == r);
+    if (d.high() == typename T::value_type{0}) {
+        const auto [q_low, r_low] = n / d.low();
+        assert(q_low == q && T{r_low} == r);
+        typename T::value_type r_low_only;
+        assert((T::template divide<true, false>(n, d.low(), nullptr) == q));
+        T::template divide<false, true>(n, d.low(), &r_low_only);
+        assert(T{r_low_only} == r);
+    }
+}
+
+template <typename T>
+void check_division_random(std::mt19937_64& gen, int iterations)
+{
+    check_division(T::max(), T{3});
+    check_division(T::max(), T::max());
+    check_division(T::max(), T::max() >> 1);
+    check_division(T::max() - T{1}, T::max());
+    for (int i = 0; i < iterations; ++i) {
+        const T n = random_ubig<T>(gen);
+        T d = random_ubig<T>(gen) >> (gen() % T::WIDTH);
+        if (d == T{0})
+            d = T{1};
+        check_division(n, d);
+        check_division(T::max(), d);
+        // Делитель вида 2^k - 1 и делимое "все единицы" - худший случай оценки цифры частного.
+        check_division(n, T::max() >> (gen() % T::WIDTH));
+        // Деление на слово по обратной величине делителя.
+        const uint64_t d64 = std::max<uint64_t>(gen() >> (gen() % 64), 1);
+        const auto [q64, r64] = n.divrem_u64(d64);
+        const auto [q, r] = n / T{d64};
+        assert(q64 == q && T{r64} == r && n.mod_u64(d64) == r64);
+    }
+}
+
+void division_test()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+
+    std::cout << "Running division tests..." << std::endl;
+    // Деление доступно и в constexpr-вычислениях (алгоритм D без выделения памяти).
+    static_assert((U512::max() / U512{3}).second == U512{0});
+    static_assert((U512::max() / (U512::max() >> 1)).first == U512{2});
+    static_assert(U512::max() % U512{7} == U512{3});
+    static_assert(U512::max().mod_u64(7) == 3);
+    static_assert(U512::max().divrem_u64(~0ull).first == (U512::max() / U512{~0ull}).first);
+    static_assert(U512::divide<true, false>(U512::max(), U512::max() >> 1, nullptr) == U512{2});
+    {
+        // Пробное деление произведения малых простых.
+        constexpr uint64_t primes[]{3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47};
+        U1024 n{1};
+        for (uint64_t p : primes)
+            n = n * U1024{p} * U1024{p};
+        for (uint64_t p : primes)
+            assert(n.mod_u64(p) == 0 && n.mod_u64(p * p) == 0);
+        assert(n.mod_u64(2) == 1 && n.mod_u64(53) != 0);
+    }
+    check_division_random<U256>(gen, 5000);
+    check_division_random<U512>(gen, 2000);
+    check_division_random<U1024>(gen, 1000);
+    check_division_random<U4096>(gen, 200);
+    // 256 слов: делители от 160 слов делятся методом Буркеля-Циглера.
+    check_division_random<UBig<UBig<U4096>>>(gen, 30);
+    std::cout << "Division tests passed!" << std::endl;
+}
+
+template <typename T>
+void check_word_arithmetic(std::mt19937_64& gen, int iterations)
+{
+    for (int i = 0; i < iterations; ++i) {
+        const T x = random_ubig<T>(gen);
+        const uint64_t k = gen() >> (gen() % 64);
+        const uint64_t c = gen();
+        const auto wide = UBig<T>::mult_ext(x, T{k}) + UBig<T>{T{c}};
+        T y = x;
+        assert(y.mul_add_u64(k, c) == wide.high().to_limbs()[0] && y == wide.low());
+        assert(wide.high() >> 64 == T{0});
+        y = x;
+        assert(y.mul_u64(k) == UBig<T>::mult_ext(x, T{k}).high().to_limbs()[0] && y == x * T{k});
+        assert(low64::ULOW{k} * x == x * T{k});
+        y = x;
+        assert(y.add_u64(c) == (x + T{c} < x ? 1 : 0) && y == x + T{c});
+    }
+}
+
+void word_arithmetic_test()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+
+    std::cout << "Running word arithmetic tests..." << std::endl;
+    static_assert([] {
+        U512 x = U512::max();
+        const uint64_t carry = x.add_u64(1);
+        return carry == 1 && x == U512{0};
+    }());
+    static_assert([] {
+        U512 x = U512::max();
+        const uint64_t carry = x.mul_add_u64(~0ull, ~0ull);
+        // (2^512 - 1)(2^64 - 1) + 2^64 - 1 = 2^576 - 2^512.
+        return carry == ~0ull && x == U512{0};
+    }());
+    check_word_arithmetic<U256>(gen, 5000);
+    check_word_arithmetic<U1024>(gen, 2000);
+    check_word_arithmetic<U4096>(gen, 500);
+    std::cout << "Word arithmetic tests passed!" << std::endl;
+}
+
+template <typename T>
+void check_flat_ops(std::mt19937_64& gen, int iterations)
+{
+    using H = typename T::value_type;
+    for (int i = 0; i < iterations; ++i) {
+        const T a = random_ubig<T>(gen);
+        const T b = random_ubig<T>(gen);
+        // Сложение и вычитание по половинкам.
+        const H low = a.low() + b.low();
+        assert((a + b == T{low, a.high() + b.high() + H{low < a.low() ? 1u : 0u}}));
+        const H diff = a.low() - b.low();
+        assert((a - b == T{diff, a.high() - b.high() - H{a.low() < b.low() ? 1u : 0u}}));
+        // Сдвиги сверяются с умножением на степень двойки и со сдвигом половинок.
+        const uint32_t s = static_cast<uint32_t>(gen() % (T::WIDTH + 1));
+        T p2{0};
+        if (s < T::WIDTH)
+            p2.limbs()[s / 64] = 1ull << (s % 64);
+        assert(a << s == a * p2);
+        if (s >= T::HALF_WIDTH)
+            assert((a >> s == T{s < T::WIDTH ? a.high() >> (s - T::HALF_WIDTH) : H{0}, H{0}}));
+        else if (s > 0)
+            assert((a >> s == T{(a.low() >> s) | (a.high() << (T::HALF_WIDTH - s)), a.high() >> s}));
+    }
+}
+
+void flat_limbs_test()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+
+    std::cout << "Running flat limbs tests..." << std::endl;
+    {
+        U1024 x{0};
+        const auto span = x.limbs();
+        static_assert(span.size() == U1024::LIMBS);
+        span[0] = 5;
+        span[U1024::LIMBS - 1] = 1ull << 63;
+        assert((x == U1024{U512{5}, U512{1} << 511}));
+        assert(x.to_limbs()[U1024::LIMBS - 1] == span[U1024::LIMBS - 1]);
+    }
+    {
+        // Иерархический путь (constexpr) и "плоский" (во время выполнения) дают одно и то же.
+        constexpr U2048 c = ((U2048::max() >> 100) + (U2048{12345} << 700)) - (U2048{1} << 1500);
+        volatile uint32_t s1 = 100, s2 = 700, s3 = 1500;
+        assert(((U2048::max() >> s1) + (U2048{12345} << s2)) - (U2048{1} << s3) == c);
+    }
+    check_flat_ops<U512>(gen, 5000);
+    check_flat_ops<U1024>(gen, 3000);
+    check_flat_ops<U4096>(gen, 500);
+    std::cout << "Flat limbs tests passed!" << std::endl;
+}
+
+void carry_kernels_test()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+
+    std::cout << "Running carry kernels tests..." << std::endl;
+    // Переносимые циклы (constexpr) и аппаратные цепочки переносов (во время выполнения) дают одно и то же.
+    static_assert([] {
+        uint64_t a[3]{~0ull, ~0ull, 1}, b[3]{1, 0, ~0ull}, r[3]{};
+        const uint64_t carry = limbs::add_n(r, a, b, 3);
+        const uint64_t borrow = limbs::sub_n(a, r, b, 3);
+        return carry == 1 && r[0] == 0 && r[1] == 0 && r[2] == 1 && borrow == 1 && a[0] == ~0ull && a[2] == 1;
+    }());
+    for (size_t n : {1, 3, 4, 7, 8, 9, 15, 16, 33, 64, 101}) {
+        for (int i = 0; i < 200; ++i) {
+            std::vector<uint64_t> a(n), b(n), r(n), expected(n);
+            for (size_t j = 0; j < n; ++j) {
+                // Много слов "все единицы" - длинные цепочки переносов.
+                a[j] = gen() % 4 == 0 ? ~0ull : gen();
+                b[j] = gen() % 4 == 0 ? ~0ull : gen();
+                r[j] = expected[j] = gen() % 4 == 0 ? ~0ull : gen();
+            }
+            const uint64_t k = i == 0 ? ~0ull : gen();
+            assert(limbs::addmul_1(r.data(), a.data(), n, k) == limbs::addmul_1_generic(expected.data(), a.data(), n, k));
+            assert(r == expected);
+            std::vector<uint64_t> sum(n), back(n);
+            const uint64_t carry = limbs::add_n(sum.data(), a.data(), b.data(), n);
+            const uint64_t borrow = limbs::sub_n(back.data(), sum.data(), b.data(), n);
+            assert(back == a && carry == borrow);
+        }
+    }
+    std::cout << "Carry kernels tests passed!" << std::endl;
+}
+
+// Проверка UInt<Bits> по эталону - UBig большей разрядности с усечением результата до Bits бит.
+template <size_t Bits, typename Wide>
+void check_uint_against(std::mt19937_64& gen, int iterations)
+{
+    using T = UInt<Bits>;
+    const Wide mask = Wide::max() >> (Wide::WIDTH - Bits);
+    for (int i = 0; i < iterations; ++i) {
+        const Wide wa = random_ubig<Wide>(gen) & mask;
+        const Wide wb = (random_ubig<Wide>(gen) & mask) >> (gen() % Bits);
+        const T a{wa}, b{wb};
+        assert(a == wa && b == wb && Wide(a) == wa);
+        assert((a < b) == (wa < wb) && (a <=> wb) == (wa <=> wb));
+        assert(a + b == ((wa + wb) & mask));
+        assert(a - b == ((wa - wb) & mask));
+        assert(a * b == ((wa * wb) & mask));
+        const uint32_t s = static_cast<uint32_t>(gen() % (Bits + 1));
+        assert((a << s) == ((wa << s) & mask) && (a >> s) == (wa >> s));
+        assert(a.countl_zero() == wa.countl_zero() - (Wide::WIDTH - Bits) && a.popcount() == wa.popcount());
+        if (wb != Wide{0}) {
+            const auto [q, r] = a / b;
+            const auto [wq, wr] = wa / wb;
+            assert(q == wq && r == wr && a % b == wr);
+        }
+        const std::string str = a.toString();
+        assert(str == wa.toString() && T::fromString(str) == a);
+    }
+}
+
+void uint_test()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+
+    std::cout << "Running UInt tests..." << std::endl;
+    static_assert(sizeof(U192) == 24 && sizeof(U320) == 40);
+    static_assert(U192::max().countl_zero() == 0 && (U192::max() >> 191) == U192{1});
+    static_assert((U192::max() / U192{3}).second == U192{0});
+    static_assert(U192::fromString("6277101735386680763835789423207666416102355444464034512895") == U192::max());
+    static_assert(U192{U256::max()} == U192::max() && U192{U128::max()} == U128::max());
+    static_assert(U256{U192::max()} == (U256::max() >> 64));
+    static_assert(U192::max() > U128::max() && U192{5} < U256{6});
+    // 192 x 128 -> 320 бит.
+    static_assert(mult_ext(U192::max(), UInt<128>::max()) ==
+                  U320{U512::mult_ext(U256::max() >> 64, U256{U128::max()})});
+    check_uint_against<192, U256>(gen, 3000);
+    check_uint_against<320, U512>(gen, 2000);
+    check_uint_against<576, U1024>(gen, 1000);
+    for (int i = 0; i < 1000; ++i) {
+        const U256 wa = random_ubig<U256>(gen) >> 64;
+        const U128 wb{gen(), gen()};
+        const U512 expected = U512::mult_ext(wa, U256{wb});
+        assert(mult_ext(U192{wa}, UInt<128>{wb}) == expected && mult_ext(UInt<128>{wb}, U192{wa}) == expected);
+    }
+    std::cout << "UInt tests passed!" << std::endl;
+}
+
+template <typename T>
+void check_square(std::mt19937_64& gen, int iterations)
+{
+    for (int i = 0; i < iterations; ++i) {
+        const T x = random_ubig<T>(gen) >> (gen() % T::WIDTH);
+        const T y = x;
+        assert(x.square() == x * y && x * x == x * y);
+        const uint32_t e = static_cast<uint32_t>(gen() % 200);
+        T naive{1};
+        for (uint32_t k = 0; k < e; ++k)
+            naive = naive * y;
+        assert(u128_utils::int_power_fast(x, e) == naive);
+    }
+}
+
+void square_test()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+
+    std::cout << "Running square tests..." << std::endl;
+    static_assert(U512::max().square() == U512{1});
+    static_assert((U512{1} << 300).square() == U512{0});
+    static_assert(u128_utils::int_power_fast(U256{3}, 161) == U256::fromString("65542350158517637872691969508970705427701150314738255642438471845988797065603"));
+    check_square<U256>(gen, 2000);
+    check_square<U512>(gen, 1000);
+    check_square<U2048>(gen, 100);
+    std::cout << "Square tests passed!" << std::endl;
+}
+
+
+template <typename T>
+constexpr bool mulhi_matches(const T& x, const T& y)
+{
+    const T exact = UBig<T>::mult_ext(x, y).high();
+    const T approx = T::mul_hi_approx(x, y);
+    return T::mulhi(x, y) == exact && approx <= exact && exact - approx <= T{1};
+}
+
+template <typename T>
+void check_mulhi(std::mt19937_64& gen, int iterations)
+{
+    assert(mulhi_matches(T::max(), T::max()));
+    for (int i = 0; i < iterations; ++i) {
+        const T x = random_ubig<T>(gen) >> (gen() % T::WIDTH);
+        const T y = (i % 2 == 0) ? T::max() - random_ubig<T>(gen) % T{1000} : random_ubig<T>(gen);
+        assert(mulhi_matches(x, y));
+    }
+}
+
+void mulhi_test()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+
+    std::cout << "Running mulhi tests..." << std::endl;
+    static_assert(mulhi_matches(U256::max(), U256::max()));
+    static_assert(mulhi_matches(U512::max() - U512{12345}, U512::max() >> 3));
+    static_assert(u128::mulhi(U128::max(), U128::max()) == U128::max() - U128{1});
+    for (int i = 0; i < 10000; ++i) {
+        const U128 x = random_u128(gen) >> (gen() % 128);
+        const U128 y = random_u128(gen);
+        const U128 exact = u128::mult_full(x, y).second;
+        const U128 approx = u128::mul_hi_approx(x, y);
+        assert(u128::mulhi(x, y) == exact && approx <= exact && exact - approx <= U128{1});
+    }
+    check_mulhi<U256>(gen, 5000);
+    check_mulhi<U512>(gen, 2000);
+    check_mulhi<U2048>(gen, 200);
+    check_mulhi<U4096>(gen, 50);
+    std::cout << "Mulhi tests passed!" << std::endl;
+}
+
+
+template <typename T>
+constexpr bool mul_wide_matches(const T& x, const typename T::value_type& y)
+{
+    using H = typename T::value_type;
+    const auto [low, high] = T::mul_wide(x, y);
+    const UBig<T> full = UBig<T>::mult_ext(x, T{y});
+    return low == full.low() && high == full.high().low() && full.high().high() == H{0};
+}
+
+template <typename T>
+void check_mul_wide(std::mt19937_64& gen, int iterations)
+{
+    using H = typename T::value_type;
+    assert(mul_wide_matches(T::max(), H::max()));
+    for (int i = 0; i < iterations; ++i) {
+        const T x = random_ubig<T>(gen) >> (gen() % T::WIDTH);
+        const T y = random_ubig<T>(gen);
+        assert(mul_wide_matches(x, y.low() >> (gen() % T::HALF_WIDTH)));
+    }
+}
+
+void mul_wide_test()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+
+    std::cout << "Running mul_wide tests..." << std::endl;
+    static_assert(mul_wide_matches(U256::max(), U128::max()));
+    static_assert(mul_wide_matches(U512::max() >> 7, U256::max() - U256{99}));
+    static_assert(U512::mul_wide(U512{1} << 511, U256{2}).second == U256{1});
+    check_mul_wide<U256>(gen, 5000);
+    check_mul_wide<U512>(gen, 2000);
+    check_mul_wide<U2048>(gen, 200);
+    // Половинки из 32 и 64 слов: два произведения limbs::mul_n со стековым буфером (с ADX - только U8192).
+    check_mul_wide<U4096>(gen, 50);
+    check_mul_wide<UBig<U4096>>(gen, 20);
+    std::cout << "Mul_wide tests passed!" << std::endl;
+}
+
+
+template <typename T>
+T mult_mod_ubig(const T& x, const T& y, const T& m)
+{
+    T r;
+    UBig<T>::template divide<false, true>(UBig<T>::mult_ext(x, y), m, &r);
+    return r;
+}
+
+template <typename T>
+void check_montgomery(std::mt19937_64& gen, int iterations)
+{
+    for (int i = 0; i < iterations; ++i) {
+        T m = random_ubig<T>(gen) >> (gen() % (T::WIDTH - 2));
+        m |= T{1};
+        const MontgomeryContext<T> ctx{m};
+        const T x = random_ubig<T>(gen);
+        const T y = random_ubig<T>(gen) % m;
+        const T xm = ctx.to_mont(x);
+        const T ym = ctx.to_mont(y);
+        assert(ctx.from_mont(xm) == x % m);
+        assert(ctx.from_mont(ctx.mul(xm, ym)) == mult_mod_ubig(x, y, m));
+        assert(ctx.from_mont(ctx.add(xm, ym)) == ((UBig<T>{x % m} + UBig<T>{y}) % UBig<T>{m}).low());
+        // Показатели разной длины: окна от 1 до 6 бит; модули - нечетные и четные.
+        const T e = random_ubig<T>(gen) >> (gen() % T::WIDTH);
+        for (const T& mod : {m, m + T{1}}) {
+            T naive = T{1} % mod;
+            for (int b = static_cast<int>(e.bit_width()) - 1; b >= 0; --b) {
+                naive = mult_mod_ubig(naive, naive, mod);
+                if (((e >> b).to_limbs()[0] & 1ull) != 0)
+                    naive = mult_mod_ubig(naive, x % mod, mod);
+            }
+            assert(u128_utils::powmod(x, e, mod) == naive);
+        }
+    }
+}
+
+void montgomery_ubig_test()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+
+    std::cout << "Running UBig Montgomery tests..." << std::endl;
+    static_assert(MontgomeryContext<U256>{U256{97}}.from_mont(MontgomeryContext<U256>{U256{97}}.to_mont(U256{1000})) == U256{30});
+    {
+        // Малая теорема Ферма для p = 2^255 - 19.
+        const U256 p = (U256{1} << 255) - U256{19};
+        assert(u128_utils::powmod(U256{3}, p - U256{1}, p) == U256{1});
+        assert(u128_utils::powmod(U256::max(), p - U256{1}, p) == U256{1});
+        assert(u128_utils::powmod(U256{2}, U256{255}, p) == U256{19});
+        const U512 p2{p};
+        assert(u128_utils::powmod(U512{5}, p2 - U512{1}, p2) == U512{1});
+        assert(u128_utils::powmod(U512{7}, U512{0}, p2) == U512{1});
+        assert(u128_utils::powmod(U512{7}, U512{3}, U512{1}) == U512{0});
+    }
+    check_montgomery<U256>(gen, 200);
+    check_montgomery<U512>(gen, 50);
+    check_montgomery<U2048>(gen, 3);
+    std::cout << "UBig Montgomery tests passed!" << std::endl;
+}
+
+
+template <typename T>
+void check_fixed_base_pow(std::mt19937_64& gen, int iterations)
+{
+    T m = random_ubig<T>(gen) | T{1};
+    const T g = random_ubig<T>(gen) % m;
+    for (uint32_t teeth : {0u, 1u, 3u, 5u}) {
+        const FixedBasePow<T> fixed{g, m, T::WIDTH, teeth};
+        assert(fixed.max_exp_bits() >= T::WIDTH);
+        assert(fixed.pow(T{0}) == T{1});
+        assert(fixed.pow(T::max()) == u128_utils::powmod(g, T::max(), m));
+        for (int i = 0; i < iterations; ++i) {
+            const T e = random_ubig<T>(gen) >> (gen() % T::WIDTH);
+            assert(fixed.pow(e) == u128_utils::powmod(g, e, m));
+        }
+    }
+}
+
+void fixed_base_pow_test()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+
+    std::cout << "Running fixed-base power tests..." << std::endl;
+    {
+        const U128 p = U128::max() - U128{158}; // 2^128 - 159, простое.
+        const FixedBasePow<U128> fixed{U128{3}, p};
+        assert(fixed.pow(p - U128{1}) == U128{1});
+        // Короткие показатели: таблица на 20 бит.
+        const FixedBasePow<U128> small{U128{5}, p, 20};
+        for (uint64_t e = 0; e < 2000; e += 7)
+            assert(small.pow(U128{e}) == u128_utils::powmod(U128{5}, U128{e}, p));
+        for (int i = 0; i < 500; ++i) {
+            const U128 e = random_u128(gen) >> (gen() % 128);
+            assert(fixed.pow(e) == u128_utils::powmod(U128{3}, e, p));
+        }
+    }
+    check_fixed_base_pow<U256>(gen, 100);
+    check_fixed_base_pow<U1024>(gen, 10);
+    std::cout << "Fixed-base power tests passed!" << std::endl;
+}
+
+
+template <typename T>
+T multi_powmod_reference(const std::vector<T>& bases, const std::vector<T>& exps, const T& m)
+{
+    T r = T{1} % m;
+    for (size_t i = 0; i < bases.size(); ++i) {
+        const T p = u128_utils::powmod(bases[i], exps[i], m);
+        if constexpr (std::is_same_v<T, U128>)
+            r = u128_utils::mult_mod(r, p, m);
+        else
+            r = mult_mod_ubig(r, p, m);
+    }
+    return r;
+}
+
+template <typename T>
+void check_multi_powmod(std::mt19937_64& gen, const T& m, size_t terms, int iterations)
+{
+    for (int it = 0; it < iterations; ++it) {
+        std::vector<T> bases(terms), exps(terms);
+        for (size_t i = 0; i < terms; ++i) {
+            if constexpr (std::is_same_v<T, U128>) {
+                bases[i] = random_u128(gen);
+                exps[i] = random_u128(gen) >> (gen() % 128);
+            } else {
+                bases[i] = random_ubig<T>(gen);
+                exps[i] = random_ubig<T>(gen) >> (gen() % T::WIDTH);
+            }
+        }
+        if (terms > 1)
+            exps[1] = T{0};
+        assert(u128_utils::multi_powmod(bases, exps, m) == multi_powmod_reference(bases, exps, m));
+    }
+}
+
+// Метод Пиппенджера напрямую с несколькими ширинами окна и через multi_powmod с полноразрядными показателями,
+// при которых оценка стоимости выбирает именно его.
+template <typename T>
+void check_pippenger(std::mt19937_64& gen, const T& m, size_t terms)
+{
+    std::vector<T> bases(terms), exps(terms);
+    for (size_t i = 0; i < terms; ++i) {
+        if constexpr (std::is_same_v<T, U128>) {
+            bases[i] = random_u128(gen);
+            exps[i] = random_u128(gen);
+        } else {
+            bases[i] = random_ubig<T>(gen);
+            std::array<uint64_t, T::LIMBS> limbs;
+            for (auto& limb : limbs)
+                limb = gen();
+            exps[i] = T::from_limbs(limbs);
+        }
+    }
+    exps[1] = T{0};
+    exps[2] = T{1};
+    using Words = decltype(detail::to_words(m));
+    std::vector<Words> e(terms);
+    std::vector<T> xs(terms);
+    for (size_t i = 0; i < terms; ++i) {
+        e[i] = detail::to_words(exps[i]);
+        xs[i] = bases[i] % m;
+    }
+    const auto mul = [&m](const T& a, const T& b) {
+        if constexpr (std::is_same_v<T, U128>)
+            return u128_utils::mult_mod(a, b, m);
+        else
+            return mult_mod_ubig(a, b, m);
+    };
+    const T expected = multi_powmod_reference(bases, exps, m);
+    for (uint32_t c : {1u, 2u, 3u, 5u, 8u})
+        assert(detail::pippenger_power(xs.data(), e.data(), terms, c, T{1}, mul) == expected);
+    assert(detail::pippenger_window(e.data(), terms) != 0);
+    assert(u128_utils::multi_powmod(bases, exps, m) == expected);
+}
+
+void multi_powmod_test()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+
+    std::cout << "Running multi-exponentiation tests..." << std::endl;
+    {
+        const U128 p = U128::max() - U128{158};
+        const std::vector<U128> bases{U128{3}, U128{5}};
+        // 3^(p-1) * 5^(p-1) = 1, 3^2 * 5^1 = 45.
+        assert(u128_utils::multi_powmod(bases, std::vector<U128>{p - U128{1}, p - U128{1}}, p) == U128{1});
+        assert(u128_utils::multi_powmod(bases, std::vector<U128>{U128{2}, U128{1}}, p) == U128{45});
+        assert(u128_utils::multi_powmod(std::vector<U128>{}, std::vector<U128>{}, p) == U128{1});
+    }
+    for (size_t terms : {1, 2, 3, 8}) {
+        check_multi_powmod<U128>(gen, U128::max() - U128{158}, terms, 50);
+        check_multi_powmod<U128>(gen, U128{0, 0x8000000000000000ull} + U128{6}, terms, 20);
+        check_multi_powmod<U256>(gen, U256::max().divrem_u64(3).first | U256{1}, terms, 10);
+        check_multi_powmod<U256>(gen, U256::max() - U256{1}, terms, 3);
+    }
+    // Много членов с показателями случайной длины - метод Штрауса.
+    check_multi_powmod<U128>(gen, U128::max() - U128{158}, 1000, 1);
+    check_multi_powmod<U256>(gen, U256::max().divrem_u64(3).first | U256{1}, 600, 1);
+    // Метод Пиппенджера: нечетные модули (Монтгомери) и четные (Барретт для U128, деление для UBig).
+    check_pippenger<U128>(gen, U128::max() - U128{158}, 400);
+    check_pippenger<U128>(gen, U128{0, 0x8000000000000000ull} + U128{6}, 400);
+    check_pippenger<U256>(gen, U256::max().divrem_u64(3).first | U256{1}, 400);
+    check_pippenger<U256>(gen, U256::max() - U256{1}, 400);
+    std::cout << "Multi-exponentiation tests passed!" << std::endl;
+}
+
+
+template <uint32_t Bits, uint64_t C>
+void check_pseudo_mersenne(std::mt19937_64& gen, int iterations)
+{
+    using F = PseudoMersenneField<Bits, C>;
+    using T = typename F::value_type;
+    const T p = F::modulus();
+    const auto mult_mod_ref = [&p](const T& a, const T& b) {
+        if constexpr (std::is_same_v<T, U128>)
+            return u128_utils::mult_mod(a, b, p);
+        else
+            return mult_mod_ubig(a, b, p);
+    };
+    const auto random_element = [&gen]() {
+        if constexpr (std::is_same_v<T, U128>)
+            return random_u128(gen);
+        else
+            return random_ubig<T>(gen);
+    };
+    const T minus_one = p - T{1};
+    assert(F::mul(minus_one, minus_one) == T{1});
+    assert(F::sqr(minus_one) == T{1});
+    assert(F::reduce(T::max()) == T::max() % p);
+    assert(F::add(minus_one, T{2}) == T{1});
+    assert(F::sub(T{0}, T{1}) == minus_one);
+    for (int it = 0; it < iterations; ++it) {
+        const T x = random_element();
+        const T a = x % p;
+        const T b = random_element() % p;
+        assert(F::reduce(x) == a);
+        assert(F::mul(a, b) == mult_mod_ref(a, b));
+        assert(F::sqr(a) == mult_mod_ref(a, a));
+        assert(F::add(a, b) == (a >= p - b ? a - (p - b) : a + b));
+        assert(F::add(F::sub(a, b), b) == a);
+    }
+    const T g = random_element() % p;
+    const T e = random_element();
+    assert(F::pow(g, e) == u128_utils::powmod(g, e, p));
+}
+
+void pseudo_mersenne_test()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+
+    std::cout << "Running pseudo-Mersenne field tests..." << std::endl;
+    using F127 = PseudoMersenneField<127, 1>;
+    static_assert(F127::modulus() == U128{~0ull, ~0ull >> 1});
+    static_assert(F127::mul(F127::modulus() - U128{1}, U128{2}) == F127::modulus() - U128{2});
+    using F255 = PseudoMersenneField<255, 19>;
+    static_assert(std::is_same_v<F255::value_type, U256>);
+    // Обратный элемент по малой теореме Ферма (2^255 - 19 - простое).
+    assert(F255::mul(F255::inv(U256{121666}), U256{121666}) == U256{1});
+    check_pseudo_mersenne<127, 1>(gen, 10000);
+    check_pseudo_mersenne<128, 159>(gen, 10000);
+    check_pseudo_mersenne<89, 1>(gen, 10000);
+    check_pseudo_mersenne<255, 19>(gen, 2000);
+    check_pseudo_mersenne<256, 0xFFFFFFFFu>(gen, 2000);
+    check_pseudo_mersenne<192, 237>(gen, 2000);
+    check_pseudo_mersenne<521, 1>(gen, 500);
+    std::cout << "Pseudo-Mersenne field tests passed!" << std::endl;
+}
+
+}
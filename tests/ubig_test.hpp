@@ -12,4 +12,38 @@ namespace tests_ubig
     void test_u256_division();
 
     void stress_test_u256(int iterations = 100000);
+
+    void divider_test();
+
+    void from_chars_test();
+
+    void to_string_test();
+
+    void multiplication_test();
+
+    void ntt_multiply_test();
+
+    void division_test();
+
+    void word_arithmetic_test();
+
+    void flat_limbs_test();
+
+    void carry_kernels_test();
+
+    void uint_test();
+
+    void square_test();
+
+    void mulhi_test();
+
+    void mul_wide_test();
+
+    void montgomery_ubig_test();
+
+    void fixed_base_pow_test();
+
+    void multi_powmod_test();
+
+    void pseudo_mersenne_test();
 }
\ No newline at end of file
@@ -15,6 +15,9 @@
 #include <bit>
 #include <compare>
 #include <type_traits>
+#include <charconv>
+#include <system_error>
+#include "decimal.hpp"
 
 #if defined(_MSC_VER) && (_MSC_VER >= 1920) && defined(_M_X64)
 #define USE_MSVC_INTRINSICS_DIVISION
@@ -328,6 +331,55 @@ namespace bignum::u128
         return *this;
     }
 
+    /**
+     * @brief Полное произведение двух 128-битных чисел: 256 бит в виде пары {младшая, старшая} половинки.
+     */
+    inline constexpr std::pair<U128, U128> mult_full(const U128 &x, const U128 &y) noexcept
+    {
+        const U128 ll = U128::mult_ext(x.low(), y.low());
+        const U128 lh = U128::mult_ext(x.low(), y.high());
+        const U128 hl = U128::mult_ext(x.high(), y.low());
+        const U128 hh = U128::mult_ext(x.high(), y.high());
+        U128 mid = U128{ll.high()} + U128{lh.low()};
+        mid += U128{hl.low()};
+        U128 high = hh + U128{lh.high()};
+        high += U128{hl.high()};
+        high += U128{mid.high()};
+        return {U128{ll.low(), mid.low()}, high};
+    }
+
+    /**
+     * @brief Старшая половина произведения двух 128-битных чисел: floor(x * y / 2^128).
+     * @details От произведения младших слов нужен только перенос, младшие 128 бит не собираются.
+     */
+    inline constexpr U128 mulhi(const U128 &x, const U128 &y) noexcept
+    {
+        const U128 ll = U128::mult_ext(x.low(), y.low());
+        const U128 lh = U128::mult_ext(x.low(), y.high());
+        const U128 hl = U128::mult_ext(x.high(), y.low());
+        U128 mid = U128{ll.high()} + U128{lh.low()};
+        mid += U128{hl.low()};
+        U128 high = U128::mult_ext(x.high(), y.high()) + U128{lh.high()};
+        high += U128{hl.high()};
+        return high + U128{mid.high()};
+    }
+
+    /**
+     * @brief Приближенная старшая половина произведения: mulhi(x, y) - e, где e - 0 или 1.
+     * @details Произведение младших слов (меньше 2^128) не вычисляется: оно добавляет к сумме средних
+     * произведений меньше 2^64 и может изменить старшую половину не более чем на единицу.
+     * Три умножения 64x64 вместо четырех.
+     */
+    inline constexpr U128 mul_hi_approx(const U128 &x, const U128 &y) noexcept
+    {
+        const U128 lh = U128::mult_ext(x.low(), y.high());
+        const U128 hl = U128::mult_ext(x.high(), y.low());
+        const U128 mid = U128{lh.low()} + U128{hl.low()};
+        U128 high = U128::mult_ext(x.high(), y.high()) + U128{lh.high()};
+        high += U128{hl.high()};
+        return high + U128{mid.high()};
+    }
+
     // Низкоуровневое деление 128/64 для эмуляции
     inline constexpr u64 div_internal(u64 h, u64 l, u64 d, u64 *r) noexcept
     {
@@ -405,65 +457,88 @@ namespace bignum::u128
         while (pos < s.length() && (s[pos] == ' ' || s[pos] == '+'))
             pos++;
         U128 res{0, 0};
-        while (pos < s.length())
-        {
-            u64 block = 0, mult = 1;
-            size_t end = (pos + 18 < s.length()) ? pos + 18 : s.length();
-            for (; pos < end; ++pos)
-            {
-                if (s[pos] < '0' || s[pos] > '9')
-                    break;
-                block = block * 10 + (s[pos] - '0');
-                mult *= 10;
-            }
-            res = (mult_ext(res.mLow, mult) + U128(0, res.mHigh * mult)) + U128(block, 0);
-            if (pos < s.length() && (s[pos] < '0' || s[pos] > '9'))
+        const char *p = s.data() + pos;
+        const char *const last = s.data() + s.length();
+        while (p != last)
+        {
+            u64 block;
+            const char *block_end = bignum::detail::parse_decimal_block(p, last, block);
+            if (block_end == p)
                 break;
+            const u64 mult = bignum::detail::POW10[block_end - p];
+            res = (mult_ext(res.mLow, mult) + U128(0, res.mHigh * mult)) + U128(block, 0);
+            p = block_end;
         }
         return res;
     }
 
-    inline std::string U128::toString() const
+    /**
+     * @brief Запись числа в десятичном виде в буфер [first, last) по контракту std::to_chars. Без аллокаций.
+     * @return Указатель за последней записанной цифрой; std::errc::value_too_large, если буфер мал.
+     */
+    inline constexpr std::to_chars_result to_chars(char *first, char *last, const U128 &value) noexcept
     {
-        if (!(*this))
-            return "0";
-
-        U128 copy = *this;
-        std::string s;
-        s.reserve(40); // Оптимизация аллокаций
-
-        while (copy > 0)
+        // Число разбивается на блоки по 19 цифр: value = (top * 10^19 + c1) * 10^19 + c0.
+        u64 chunks[2]{};
+        int n_chunks = 0;
+        U128 top = value;
+        while (top.high() != 0)
         {
-            U128 next_q, rem_u;
-            // Делим на 10^19
-            next_q = divide<true, true>(copy, 10000000000000000000ULL, &rem_u);
-            uint64_t r = rem_u.low();
-
-            copy = next_q;
+            U128 rem;
+            top = U128::divide<true, true>(top, U128{bignum::detail::POW10[19]}, &rem);
+            chunks[n_chunks++] = rem.low();
+        }
+        const int top_digits = bignum::detail::count_digits(top.low());
+        const int total = top_digits + 19 * n_chunks;
+        if (last - first < total)
+            return {last, std::errc::value_too_large};
+        char *end = first + total;
+        for (int i = 0; i < n_chunks; ++i, end -= 19)
+            bignum::detail::write_digits(end, chunks[i], 19);
+        bignum::detail::write_digits(end, top.low(), top_digits);
+        return {first + total, std::errc{}};
+    }
 
-            // Если это не последний блок (есть еще цифры выше),
-            // мы ОБЯЗАНЫ записать все 19 разрядов, включая нули.
-            if (copy > 0)
-            {
-                for (int i = 0; i < 19; ++i)
-                {
-                    s += (char)('0' + (r % 10));
-                    r /= 10;
-                }
-            }
-            else
-            {
-                // Если это самый старший блок, пишем только значащие цифры
-                do
-                {
-                    s += (char)('0' + (r % 10));
-                    r /= 10;
-                } while (r > 0);
-            }
-        }
+    /**
+     * @brief Чтение десятичного числа из [first, last) по контракту std::from_chars (без знака и пробелов).
+     * @return Указатель на первый неразобранный символ; std::errc::invalid_argument, если цифр нет;
+     * std::errc::result_out_of_range при переполнении (value не изменяется).
+     */
+    inline constexpr std::from_chars_result from_chars(const char *first, const char *last, U128 &value) noexcept
+    {
+        const char *p = first;
+        U128 res{0};
+        bool overflow = false;
+        while (p != last)
+        {
+            u64 block;
+            const char *block_end = bignum::detail::parse_decimal_block(p, last, block);
+            if (block_end == p)
+                break;
+            const u64 mult = bignum::detail::POW10[block_end - p];
+            p = block_end;
+            // res = res * mult + block с контролем переполнения.
+            const U128 lo = U128::mult_ext(res.low(), mult);
+            const U128 hi = U128::mult_ext(res.high(), mult);
+            U128 next = lo + U128{0, hi.low()};
+            overflow |= hi.high() != 0 || next.high() < lo.high();
+            next += U128{block};
+            overflow |= next < U128{block};
+            res = next;
+        }
+        if (p == first)
+            return {first, std::errc::invalid_argument};
+        if (overflow)
+            return {p, std::errc::result_out_of_range};
+        value = res;
+        return {p, std::errc{}};
+    }
 
-        std::reverse(s.begin(), s.end());
-        return s;
+    inline std::string U128::toString() const
+    {
+        char buf[39]; // 2^128 - 1 содержит 39 десятичных цифр.
+        const auto [ptr, ec] = to_chars(buf, buf + sizeof(buf), *this);
+        return std::string(buf, ptr);
     }
 
     inline constexpr U128 operator""_u128(const char *str, std::size_t len) { return U128::fromString({str, len}); }
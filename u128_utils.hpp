@@ -4,8 +4,14 @@
 #include "i128.hpp"
 #include <cassert>
 #include <utility> // std::pair
+#include <span>
+#include <type_traits>
+#include <vector>
 #include "ubig.hpp"
 #include "ulow.hpp"
+#include "barrett.hpp"
+#include "montgomery.hpp"
+#include "divider.hpp"
 
 namespace u128_utils
 {
@@ -86,6 +92,22 @@ inline U128 int_power_fast(U128 x, uint32_t y) noexcept
 }
 
 
+/**
+ * @brief Быстрое возведение в степень x^y mod 2^N для UBig (бинарный метод "слева направо").
+ * @details Все возведения в квадрат идут через UBig::square(), которое экономит одно произведение половинок.
+ */
+template <typename T>
+constexpr bignum::UBig<T> int_power_fast(const bignum::UBig<T>& x, uint32_t y) noexcept(bignum::UBig<T>::NOTHROW_MULT_EXT)
+{
+    if (y == 0) return bignum::UBig<T>{1};
+    bignum::UBig<T> result = x;
+    for (int i = std::bit_width(y) - 2; i >= 0; --i) {
+        result = result.square();
+        if ((y >> i) & 1u) result = result * x;
+    }
+    return result;
+}
+
 /**
  * @brief Целочисленный корень m-й степени из x.
  */
@@ -106,6 +128,7 @@ inline U128 nroot(const U128& x, uint32_t m)
 
     U128 m_val{m};
     U128 m_minus_1 = m_val - 1;
+    const bignum::Divider<U128> m_divider{m_val};
 
     for (;;) {
         U128 p = int_power_fast(x0, m - 1);
@@ -116,7 +139,7 @@ inline U128 nroot(const U128& x, uint32_t m)
         U128 x1;
         if (x0 > quotient) {
             // Идем вниз: x1 = x0 - (x0 - quotient) / m
-            U128 diff = (x0 - quotient) / m_val;
+            U128 diff = m_divider.quot(x0 - quotient);
             
             // КРИТИЧЕСКИЙ МОМЕНТ: если diff == 0, но x0 > quotient, 
             // это не значит, что мы на месте. Это значит, что шаг < 1.
@@ -146,11 +169,12 @@ inline U128 nroot(const U128& x, uint32_t m)
 inline bool is_quadratic_residue(const U128& x, const U128& p)
 {
     assert(p != 0);
-    const auto rx = x % p;
+    const bignum::BarrettReducer reducer{p};
+    const auto rx = reducer.reduce(x);
     U128 y2 = 0;
     for (U128 y = 0; y < p; y++)
     {                
-        if (const auto ry2 = y2 % p; ry2 == rx)
+        if (const auto ry2 = reducer.reduce(y2); ry2 == rx)
             return true;
         y2 += (y + y + 1);
     }
@@ -198,11 +222,12 @@ inline std::pair<U128, U128> sqrt_mod(const U128& x, const U128& p)
     assert(p != 0);
     U128 result[2];
     int idx = 0;
-    const auto rx = x % p;
+    const bignum::BarrettReducer reducer{p};
+    const auto rx = reducer.reduce(x);
     U128 y2 = 0;
     for (U128 y = 0; y < p; y++)
     {
-        if (const auto ry2 = y2 % p; ry2 == rx)
+        if (const auto ry2 = reducer.reduce(y2); ry2 == rx)
             result[idx++] = y;
         y2 += (y + y + 1);
         if (idx == 2) break;
@@ -225,7 +250,8 @@ inline U128 div_mod(const U128& x, const U128& y, const U128& p)
         assert(rx == 0);
         return 0;
     }
-    while ((rx % ry) != 0)
+    const bignum::BarrettReducer reducer{ry};
+    while (reducer.reduce(rx) != 0)
         rx += p;
     return rx / ry; 
 }
@@ -240,7 +266,112 @@ inline U128 mult_mod(const U128& x, const U128& y, const U128& m)
     using namespace bignum;
     using U256 = UBig<U128>;
     const U256 z = U256::mult_ext(x, y);
-    return (z / m).second;
+    U128 r;
+    U256::divide<false, true>(z, m, &r);
+    return r;
+}
+
+
+/**
+ * @brief Возведение в степень по модулю: base^exp mod m.
+ * @details Для нечетного модуля умножения идут в форме Монтгомери (MontgomeryContext), для четного -
+ * с редукцией Барретта (BarrettReducer); в обоих случаях без деления 256/128 на каждом шаге.
+ * Показатель обрабатывается скользящим окном, ширина которого выбирается по битовой длине показателя.
+ */
+inline U128 powmod(const U128& base, const U128& exp, const U128& m)
+{
+    assert(m != 0);
+    if (m == 1)
+        return 0;
+    const uint64_t e[2]{exp.low(), exp.high()};
+    if ((m.low() & 1ull) != 0)
+    {
+        const bignum::MontgomeryContext<U128> ctx{m};
+        const auto mul = [&ctx](const U128& a, const U128& b) { return ctx.mul(a, b); };
+        return ctx.from_mont(bignum::detail::sliding_window_power(ctx.to_mont(base), e, exp.bit_width(), ctx.one(), mul));
+    }
+    const bignum::BarrettReducer reducer{m};
+    const auto mul = [&reducer](const U128& a, const U128& b) { return reducer.mul(a, b); };
+    return bignum::detail::sliding_window_power(reducer.reduce(base), e, exp.bit_width(), U128{1}, mul);
+}
+
+/**
+ * @brief Возведение в степень по модулю для UBig: base^exp mod m.
+ * @details Для нечетного модуля - в форме Монтгомери (MontgomeryContext<UBig>) без деления на каждом шаге;
+ * для четного - произведение с расширением и остаток от деления. Показатель обрабатывается скользящим окном.
+ */
+template <typename T>
+inline bignum::UBig<T> powmod(const bignum::UBig<T>& base, const bignum::UBig<T>& exp, const bignum::UBig<T>& m)
+{
+    using U = bignum::UBig<T>;
+    assert(m != U{0});
+    if (m == U{1})
+        return U{0};
+    const auto e = exp.to_limbs();
+    if ((m.to_limbs()[0] & 1ull) != 0)
+    {
+        const bignum::MontgomeryContext<U> ctx{m};
+        const auto mul = [&ctx](const U& a, const U& b) { return ctx.mul(a, b); };
+        return ctx.from_mont(bignum::detail::sliding_window_power(ctx.to_mont(base), e.data(), exp.bit_width(), ctx.one(), mul));
+    }
+    const auto mul = [&m](const U& a, const U& b)
+    {
+        U r;
+        bignum::UBig<U>::template divide<false, true>(bignum::UBig<U>::mult_ext(a, b), m, &r);
+        return r;
+    };
+    return bignum::detail::sliding_window_power(base % m, e.data(), exp.bit_width(), U{1}, mul);
+}
+
+
+/**
+ * @brief Произведение степеней по модулю: prod bases[i]^exps[i] mod m (например, g^a * h^b при проверке подписей).
+ * @details Одна общая цепочка возведений в квадрат на все основания: метод Штрауса (трюк Шамира) с чередующимися
+ * скользящими окнами, а при большом числе членов - метод Пиппенджера; выбор - по оценке числа умножений.
+ * Для нечетного модуля - форма Монтгомери, для четного - редукция Барретта (U128) или деление (UBig).
+ * @tparam T U128 или UBig; выводится по модулю, поэтому основания и показатели можно передать, например, std::vector.
+ */
+template <typename T>
+inline T multi_powmod(std::span<const std::type_identity_t<T>> bases, std::span<const std::type_identity_t<T>> exps, const T& m)
+{
+    assert(bases.size() == exps.size());
+    assert(m != T{0});
+    if (m == T{1})
+        return T{0};
+    using Words = decltype(bignum::detail::to_words(m));
+    const size_t n = bases.size();
+    bignum::detail::SmallBuffer<Words> e(n);
+    for (size_t i = 0; i < n; ++i)
+        e[i] = bignum::detail::to_words(exps[i]);
+    bignum::detail::SmallBuffer<T> xs(n);
+    if ((bignum::detail::to_words(m)[0] & 1ull) != 0)
+    {
+        const bignum::MontgomeryContext<T> ctx{m};
+        for (size_t i = 0; i < n; ++i)
+            xs[i] = ctx.to_mont(bases[i]);
+        const auto mul = [&ctx](const T& a, const T& b) { return ctx.mul(a, b); };
+        return ctx.from_mont(bignum::detail::multi_power(xs.data(), e.data(), n, ctx.one(), mul));
+    }
+    if constexpr (std::is_same_v<T, U128>)
+    {
+        const bignum::BarrettReducer reducer{m};
+        for (size_t i = 0; i < n; ++i)
+            xs[i] = reducer.reduce(bases[i]);
+        const auto mul = [&reducer](const U128& a, const U128& b) { return reducer.mul(a, b); };
+        return bignum::detail::multi_power(xs.data(), e.data(), n, U128{1}, mul);
+    }
+    else
+    {
+        for (size_t i = 0; i < n; ++i)
+            xs[i] = bases[i] % m;
+        const auto mul = [&m](const T& a, const T& b)
+        {
+            T r;
+            bignum::UBig<T>::template divide<false, true>(bignum::UBig<T>::mult_ext(a, b), m, &r);
+            return r;
+        };
+        return bignum::detail::multi_power(xs.data(), e.data(), n, T{1}, mul);
+    }
 }
 
 }
\ No newline at end of file
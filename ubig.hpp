@@ -10,11 +10,52 @@
 #include <compare>
 #include <algorithm>
 #include <utility>
+#include <array>
+#include <span>
+#include <type_traits>
+#include <string>
+#include <vector>
 #include "u128.hpp" // generic
+#include "limbs.hpp"
+#include "ntt.hpp"
 
 namespace bignum
 {
 
+    /**
+     * @brief Разрядность, начиная с которой UBig::mult_ext и UBig::square_ext используют метод Карацубы.
+     */
+    inline constexpr uint32_t KARATSUBA_THRESHOLD_BITS = 512;
+
+    /**
+     * @brief Разрядность, начиная с которой UBig::mult_ext и UBig::square_ext (вне constexpr-вычислений) работают
+     * над "плоским" представлением через limbs::mul_n, где метод (школьный, Карацуба, Toom-3) выбирается по длине.
+     */
+    inline constexpr uint32_t FLAT_MULT_THRESHOLD_BITS = 512;
+
+    /**
+     * @brief Разрядность, начиная с которой UBig::mult_ext и UBig::square_ext (вне constexpr-вычислений)
+     * используют умножение через NTT (ntt_multiply): при половинках из 2048 слов limbs::mul_n еще быстрее.
+     */
+    inline constexpr uint32_t NTT_MULT_THRESHOLD_BITS = 524288;
+
+    /**
+     * @brief Разрядность, начиная с которой сложение и вычитание UBig (вне constexpr-вычислений) идут
+     * одним циклом по "плоскому" представлению вместо рекурсии по половинкам.
+     */
+    inline constexpr uint32_t FLAT_ADD_THRESHOLD_BITS = 512;
+
+    /**
+     * @brief Разрядность, начиная с которой сдвиги UBig (вне constexpr-вычислений) идут по "плоскому" представлению.
+     */
+    inline constexpr uint32_t FLAT_SHIFT_THRESHOLD_BITS = 1024;
+
+    /**
+     * @brief Разрядность, начиная с которой UBig::mul_hi_approx (вне constexpr-вычислений) берет старшую половину
+     * полного произведения: короткое школьное произведение limbs::mulhi_basecase уступает методам Карацубы и Toom-3.
+     */
+    inline constexpr uint32_t MULHI_FULL_THRESHOLD_BITS = 65536;
+
     /**
      * @brief Иерархический класс для длинных чисел.
      * @tparam ULOW Тип "половинки" (например, uint64_t или U128).
@@ -30,6 +71,16 @@ namespace bignum
         static constexpr uint32_t HALF_WIDTH = static_cast<uint32_t>(bignum::generic::bit_size<ULOW>());
         static constexpr uint32_t WIDTH = HALF_WIDTH * 2;
 
+        // Количество 64-битных слов в "плоском" представлении.
+        static constexpr size_t LIMBS = WIDTH / 64;
+
+        // Наибольшее количество десятичных цифр: floor(WIDTH * log10(2)) + 1.
+        static constexpr size_t MAX_DIGITS = static_cast<size_t>(WIDTH) * 30103 / 100000 + 1;
+
+        // Произведение с расширением до WIDTH бит не бросает исключений: ниже NTT_MULT_THRESHOLD_BITS рабочий буфер
+        // на стеке, а ntt_multiply выделяет память (std::vector) и может бросить std::bad_alloc.
+        static constexpr bool NOTHROW_MULT_EXT = WIDTH < NTT_MULT_THRESHOLD_BITS;
+
         // Тип "половинки" для использования в generic-функциях
         using value_type = ULOW;
 
@@ -60,6 +111,42 @@ namespace bignum
         [[nodiscard]] constexpr ULOW &low() noexcept { return mLow; }
         [[nodiscard]] constexpr ULOW &high() noexcept { return mHigh; }
 
+        // --- "Плоское" представление ---
+        /**
+         * @brief Копия числа в виде массива 64-битных слов, младшее слово первое.
+         * @details Половинки хранятся подряд (mLow, затем mHigh), поэтому память числа - это и есть такой массив.
+         */
+        [[nodiscard]] constexpr std::array<uint64_t, LIMBS> to_limbs() const noexcept
+        {
+            static_assert(sizeof(UBig) == sizeof(std::array<uint64_t, LIMBS>));
+            return std::bit_cast<std::array<uint64_t, LIMBS>>(*this);
+        }
+
+        /**
+         * @brief Число из массива 64-битных слов, младшее слово первое.
+         */
+        static constexpr UBig from_limbs(const std::array<uint64_t, LIMBS> &limbs) noexcept
+        {
+            return std::bit_cast<UBig>(limbs);
+        }
+
+        /**
+         * @brief Представление памяти числа как массива 64-битных слов, младшее слово первое (без копирования).
+         * @details Недоступно в constexpr-вычислениях; там используются to_limbs() и from_limbs().
+         * Опирается на допущение о размещении в памяти, описанное у check_flat_layout().
+         */
+        [[nodiscard]] std::span<uint64_t, LIMBS> limbs() noexcept
+        {
+            check_flat_layout();
+            return std::span<uint64_t, LIMBS>{reinterpret_cast<uint64_t *>(this), LIMBS};
+        }
+
+        [[nodiscard]] std::span<const uint64_t, LIMBS> limbs() const noexcept
+        {
+            check_flat_layout();
+            return std::span<const uint64_t, LIMBS>{reinterpret_cast<const uint64_t *>(this), LIMBS};
+        }
+
         // --- Сравнение ---
         constexpr bool operator==(const UBig &other) const noexcept
         {
@@ -77,6 +164,14 @@ namespace bignum
         // --- Сложение ---
         constexpr UBig &operator+=(const UBig &other) noexcept
         {
+            if constexpr (WIDTH >= FLAT_ADD_THRESHOLD_BITS)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    bignum::limbs::add_n(limbs().data(), limbs().data(), other.limbs().data(), LIMBS);
+                    return *this;
+                }
+            }
             ULOW old_low = mLow;
             mLow += other.mLow;
 
@@ -101,6 +196,14 @@ namespace bignum
         // --- Вычитание ---
         constexpr UBig &operator-=(const UBig &other) noexcept
         {
+            if constexpr (WIDTH >= FLAT_ADD_THRESHOLD_BITS)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    bignum::limbs::sub_n(limbs().data(), limbs().data(), other.limbs().data(), LIMBS);
+                    return *this;
+                }
+            }
             ULOW old_low = mLow;
             mLow -= other.mLow;
 
@@ -125,6 +228,50 @@ namespace bignum
         constexpr UBig operator+(const UBig &other) const noexcept { return UBig(*this) += other; }
         constexpr UBig operator-(const UBig &other) const noexcept { return UBig(*this) -= other; }
 
+        // --- Арифметика со словом ---
+        /**
+         * @brief Умножение на слово: x = x * k (по модулю 2^WIDTH) одной цепочкой переносов.
+         * @details Вне constexpr-вычислений ядра работают прямо над limbs(), без копирования числа; так же устроены add_u64 и mul_add_u64.
+         * @return Вытесненное старшее слово произведения.
+         */
+        constexpr uint64_t mul_u64(uint64_t k) noexcept
+        {
+            if (!std::is_constant_evaluated())
+                return bignum::limbs::mul_1(limbs().data(), limbs().data(), LIMBS, k);
+            auto a = to_limbs();
+            const uint64_t carry = bignum::limbs::mul_1(a.data(), a.data(), LIMBS, k);
+            *this = from_limbs(a);
+            return carry;
+        }
+
+        /**
+         * @brief Прибавление слова: x = x + c (по модулю 2^WIDTH).
+         * @return Перенос из старшего слова.
+         */
+        constexpr uint64_t add_u64(uint64_t c) noexcept
+        {
+            if (!std::is_constant_evaluated())
+                return bignum::limbs::add_1(limbs().data(), LIMBS, c);
+            auto a = to_limbs();
+            const uint64_t carry = bignum::limbs::add_1(a.data(), LIMBS, c);
+            *this = from_limbs(a);
+            return carry;
+        }
+
+        /**
+         * @brief Умножение на слово с прибавлением слова: x = x * k + c (по модулю 2^WIDTH) одной цепочкой переносов.
+         * @return Вытесненное старшее слово результата (ноль - переполнения нет).
+         */
+        constexpr uint64_t mul_add_u64(uint64_t k, uint64_t c) noexcept
+        {
+            if (!std::is_constant_evaluated())
+                return bignum::limbs::mul_add_1(limbs().data(), LIMBS, k, c);
+            auto a = to_limbs();
+            const uint64_t carry = bignum::limbs::mul_add_1(a.data(), LIMBS, k, c);
+            *this = from_limbs(a);
+            return carry;
+        }
+
         // --- Инкремент / Декремент ---
         constexpr void inc() noexcept
         {
@@ -192,7 +339,39 @@ namespace bignum
         }
 
         // --- Умножение ---
-        static constexpr UBig mult_ext(const ULOW &x, const ULOW &y) noexcept
+        /**
+         * @brief Произведение N/2-битных чисел с расширением до N-битного числа.
+         * Начиная с разрядности KARATSUBA_THRESHOLD_BITS используется метод Карацубы (три произведения половинок вместо четырех).
+         */
+        static constexpr UBig mult_ext(const ULOW &x, const ULOW &y) noexcept(NOTHROW_MULT_EXT)
+        {
+            if constexpr (WIDTH >= FLAT_MULT_THRESHOLD_BITS)
+            {
+                if (!std::is_constant_evaluated())
+                    return mult_ext_flat(x, y);
+            }
+            if constexpr (use_karatsuba())
+            {
+                // x0 * y1 + x1 * y0 = z0 + z2 - (x1 - x0) * (y1 - y0).
+                const bool x_neg = x.high() < x.low();
+                const bool y_neg = y.high() < y.low();
+                const auto dx = x_neg ? x.low() - x.high() : x.high() - x.low();
+                const auto dy = y_neg ? y.low() - y.high() : y.high() - y.low();
+                return karatsuba_combine(ULOW::mult_ext(x.low(), y.low()),
+                                         ULOW::mult_ext(x.high(), y.high()),
+                                         ULOW::mult_ext(dx, dy),
+                                         x_neg == y_neg);
+            }
+            else
+            {
+                return mult_ext_basecase(x, y);
+            }
+        }
+
+        /**
+         * @brief Произведение с расширением через четыре произведения четвертинок (школьный метод).
+         */
+        static constexpr UBig mult_ext_basecase(const ULOW &x, const ULOW &y) noexcept
         {
             constexpr int Q = WIDTH / 4; // Четверть ширины N-битного числа.
             ULOW MASK = (ULOW{1} << Q) - ULOW{1};
@@ -220,11 +399,61 @@ namespace bignum
             return result;
         }
 
+        /**
+         * @brief Произведение с расширением над "плоским" представлением: limbs::mul_n (школьный метод,
+         * Карацуба или Toom-3 в зависимости от длины; для &x == &y - квадрат limbs::sqr_n),
+         * а начиная с NTT_MULT_THRESHOLD_BITS - ntt_multiply (с выделением памяти, поэтому там не noexcept).
+         */
+        static UBig mult_ext_flat(const ULOW &x, const ULOW &y) noexcept(NOTHROW_MULT_EXT)
+        {
+            using HalfLimbs = std::array<uint64_t, LIMBS / 2>;
+            static_assert(sizeof(ULOW) == sizeof(HalfLimbs));
+            const auto xl = std::bit_cast<HalfLimbs>(x);
+            const auto yl = std::bit_cast<HalfLimbs>(y);
+            // Для квадрата передается один и тот же массив: ntt_multiply тогда делает одно прямое преобразование.
+            const uint64_t *const yp = (&x == &y) ? xl.data() : yl.data();
+            std::array<uint64_t, LIMBS> r;
+            if constexpr (WIDTH >= NTT_MULT_THRESHOLD_BITS)
+                bignum::ntt_multiply(r.data(), xl.data(), LIMBS / 2, yp, LIMBS / 2);
+            else
+            {
+                // Рабочий буфер рекурсии - на стеке: ниже порога NTT умножение не выделяет памяти и остается noexcept.
+                std::array<uint64_t, bignum::limbs::mul_scratch_size(LIMBS / 2)> t;
+                bignum::limbs::mul_n(r.data(), xl.data(), yp, LIMBS / 2, t.data());
+            }
+            return from_limbs(r);
+        }
+
         /**
          * @brief Возведение N/2-битного числа в квадрат с расширением до N-битного числа.
+         * Начиная с разрядности KARATSUBA_THRESHOLD_BITS используется тождество 2 * x0 * x1 = x0^2 + x1^2 - (x1 - x0)^2.
+         */
+        static constexpr UBig square_ext(const ULOW &x) noexcept(NOTHROW_MULT_EXT)
+        {
+            if constexpr (WIDTH >= FLAT_MULT_THRESHOLD_BITS)
+            {
+                if (!std::is_constant_evaluated())
+                    return mult_ext_flat(x, x);
+            }
+            if constexpr (use_karatsuba())
+            {
+                const auto dx = x.high() < x.low() ? x.low() - x.high() : x.high() - x.low();
+                return karatsuba_combine(ULOW::square_ext(x.low()),
+                                         ULOW::square_ext(x.high()),
+                                         ULOW::square_ext(dx),
+                                         true);
+            }
+            else
+            {
+                return square_ext_basecase(x);
+            }
+        }
+
+        /**
+         * @brief Возведение в квадрат с расширением через три произведения четвертинок.
          * Оптимизировано по сравнению с обычным умножением (x * x).
          */
-        static constexpr UBig square_ext(const ULOW &x) noexcept
+        static constexpr UBig square_ext_basecase(const ULOW &x) noexcept
         {
             constexpr uint32_t Q = WIDTH / 4; // Четверть ширины N-битного числа.
             ULOW MASK = (ULOW{1} << Q) - ULOW{1};
@@ -247,10 +476,109 @@ namespace bignum
         }
 
         /**
-         * @brief
+         * @brief Старшая половина произведения N-битных чисел: floor(x * y / 2^N).
+         * @details Вне constexpr-вычислений - старшие слова произведения над "плоским" представлением.
+         * Иначе x * y / 2^N = x1 * y1 + (x1 * y0 + x0 * y1 + mulhi(x0, y0)) / 2^(N/2): от произведения
+         * младших половинок рекурсивно вычисляется только старшая половина.
          */
-        constexpr UBig operator*(const UBig &other) const noexcept
+        [[nodiscard]] static constexpr UBig mulhi(const UBig &x, const UBig &y) noexcept(UBig<UBig>::NOTHROW_MULT_EXT)
         {
+            if (!std::is_constant_evaluated())
+                return UBig<UBig>::mult_ext(x, y).high();
+            return mulhi_hierarchical(x, y, true);
+        }
+
+        /**
+         * @brief Приближенная старшая половина произведения: mulhi(x, y) - e, где e - 0 или 1.
+         * @details Вне constexpr-вычислений (до MULHI_FULL_THRESHOLD_BITS) - короткое произведение limbs::mulhi_basecase
+         * без частичных произведений слов с номерами i + j < LIMBS - 2, что почти вдвое дешевле полного.
+         * Иначе не вычисляется произведение младших половинок x0 * y0 < 2^N: оно добавляет к средней сумме
+         * меньше 2^(N/2) и меняет результат не более чем на единицу.
+         */
+        [[nodiscard]] static constexpr UBig mul_hi_approx(const UBig &x, const UBig &y) noexcept(UBig<UBig>::NOTHROW_MULT_EXT)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                if constexpr (WIDTH < MULHI_FULL_THRESHOLD_BITS)
+                {
+                    std::array<uint64_t, LIMBS * 2> r;
+                    bignum::limbs::mulhi_basecase(r.data(), x.limbs().data(), y.limbs().data(), LIMBS);
+                    std::array<uint64_t, LIMBS> high;
+                    std::copy_n(r.begin() + LIMBS, LIMBS, high.begin());
+                    return from_limbs(high);
+                }
+                else
+                {
+                    return UBig<UBig>::mult_ext(x, y).high();
+                }
+            }
+            return mulhi_hierarchical(x, y, false);
+        }
+
+        /**
+         * @brief Точное произведение N-битного числа на N/2-битное без расширения множителя до N бит.
+         * @details x * y = x0 * y + (x1 * y) * 2^(N/2): два произведения половинок с расширением вместо четырех.
+         * Вне constexpr-вычислений - над "плоским" представлением: школьное несимметричное умножение, а начиная
+         * с порога Карацубы - два произведения limbs::mul_n с рабочим буфером на стеке (без выделения памяти).
+         * @return Пара {младшие N бит, старшие N/2 бит} произведения (всего 1.5N бит).
+         */
+        [[nodiscard]] static constexpr std::pair<UBig, ULOW> mul_wide(const UBig &x, const ULOW &y) noexcept
+        {
+            if (!std::is_constant_evaluated())
+            {
+                constexpr size_t H = LIMBS / 2;
+                using HalfLimbs = std::array<uint64_t, H>;
+                const auto yl = std::bit_cast<HalfLimbs>(y);
+                std::array<uint64_t, LIMBS + H> r;
+                if (H < bignum::limbs::karatsuba_threshold())
+                {
+                    bignum::limbs::mul_basecase(r.data(), x.limbs().data(), LIMBS, yl.data(), H);
+                }
+                else
+                {
+                    // r = x0 * y + (x1 * y) * B^H; произведение x1 * y - в начале буфера t.
+                    std::array<uint64_t, 2 * H + bignum::limbs::mul_scratch_size(H)> t;
+                    const uint64_t *const xl = x.limbs().data();
+                    bignum::limbs::mul_n(r.data(), xl, yl.data(), H, t.data() + 2 * H);
+                    std::fill(r.begin() + 2 * H, r.end(), 0);
+                    bignum::limbs::mul_n(t.data(), xl + H, yl.data(), H, t.data() + 2 * H);
+                    bignum::limbs::add_into(r.data() + H, 2 * H, t.data(), 2 * H);
+                }
+                std::array<uint64_t, LIMBS> low;
+                HalfLimbs high;
+                std::copy_n(r.begin(), LIMBS, low.begin());
+                std::copy_n(r.begin() + LIMBS, LIMBS / 2, high.begin());
+                return {from_limbs(low), std::bit_cast<ULOW>(high)};
+            }
+            const UBig p0 = UBig::mult_ext(x.mLow, y);
+            const UBig p1 = UBig::mult_ext(x.mHigh, y);
+            UBig low = p0;
+            low.mHigh += p1.mLow;
+            ULOW high = p1.mHigh;
+            if (low.mHigh < p1.mLow)
+                ++high;
+            return {low, high};
+        }
+
+        /**
+         * @brief Квадрат по модулю 2^WIDTH: x^2 = x0^2 + 2 * x0 * x1 * 2^(WIDTH/2) (mod 2^WIDTH).
+         * @details Одно возведение в квадрат с расширением и одно усеченное произведение половинок
+         * вместо трех произведений в operator*.
+         */
+        [[nodiscard]] constexpr UBig square() const noexcept(NOTHROW_MULT_EXT)
+        {
+            UBig res = UBig::square_ext(mLow);
+            res.mHigh += (mLow * mHigh) << 1;
+            return res;
+        }
+
+        /**
+         * @brief Произведение по модулю 2^WIDTH; для x * x - через square().
+         */
+        constexpr UBig operator*(const UBig &other) const noexcept(NOTHROW_MULT_EXT)
+        {
+            if (&other == this)
+                return square();
             UBig res = UBig::mult_ext(mLow, other.mLow);
             res.mHigh += (mLow * other.mHigh);
             res.mHigh += (mHigh * other.mLow);
@@ -260,6 +588,14 @@ namespace bignum
         // --- Сдвиги ---
         constexpr UBig &operator<<=(uint32_t s) noexcept
         {
+            if constexpr (WIDTH >= FLAT_SHIFT_THRESHOLD_BITS)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    shift_left_flat(s);
+                    return *this;
+                }
+            }
             if (s >= WIDTH)
             {
                 mLow = mHigh = 0;
@@ -280,6 +616,14 @@ namespace bignum
 
         constexpr UBig &operator>>=(uint32_t s) noexcept
         {
+            if constexpr (WIDTH >= FLAT_SHIFT_THRESHOLD_BITS)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    shift_right_flat(s);
+                    return *this;
+                }
+            }
             if (s >= WIDTH)
             {
                 mLow = mHigh = 0;
@@ -324,71 +668,60 @@ namespace bignum
         constexpr UBig operator~() const noexcept { return UBig(~mLow, ~mHigh); }
 
         /**
-         * @brief Оператор деления.
-         * @details Авторский метод деления двух "широких" чисел, состоящих из двух половинок - "узких" чисел.
-         * Отсутствует "раскачка" алгоритма для "плохих" случаев деления: (A*w + B)/(1*w + D).
-         * @return Частное от деления и остаток.
+         * @brief Деление с остатком с выбором вычисляемых величин на этапе компиляции (аналог U128::divide).
+         * @details Деление над "плоским" представлением: алгоритм D Кнута (коррекция оценки цифры частного
+         * не более чем одним сложением на шаг), для длинных делителей вне constexpr-вычислений - рекурсивный
+         * метод Буркеля-Циглера (limbs::divrem_auto). При Q = false цифры частного не сохраняются,
+         * при R = false остаток не восстанавливается из нормализованного вида.
+         * @tparam Q Нужно ли частное.
+         * @tparam R Нужен ли остаток.
+         * @param rem_out Остаток (используется при R = true).
+         * @return Частное (ноль при Q = false).
          */
-        constexpr std::pair<UBig, UBig> operator/(const UBig &other) const
+        template <bool Q, bool R>
+        static constexpr UBig divide(const UBig &dividend, const UBig &divisor, UBig *rem_out)
         {
-            assert(other != UBig{0});
-
-            if (*this < other)
-                return {UBig{0}, *this};
-
-            // Оптимизация для "узкого" делителя
-            if (other.mHigh == ULOW{0})
-            {
-                auto [q, r] = *this / other.mLow;
-                return {q, UBig{r}};
-            }
-
-            // 1. Начальная оценка частного и остатка по старшим половинам
-            auto [Q, R] = divide_as_pair(mHigh, other.mHigh);
-
-            // 2. Учет вклада младших половин (Delta-коррекция)
-            constexpr ULOW MAX_V = ULOW::max();
-            const ULOW Delta = MAX_V - other.mLow;
-            const UBig DeltaQ = mult_ext(Delta, Q);
-
-            const UBig sum_1 = UBig{0, R} + DeltaQ;
-            const UBig sub_val = UBig{0, Q};
-            const bool is_neg = sum_1 < sub_val;
-
-            UBig W1 = is_neg ? (sub_val - sum_1) : (sum_1 - sub_val);
-
-            // 3. Вычисление поправочного коэффициента Quotient
-            const ULOW C1 = (other.mHigh < MAX_V) ? (other.mHigh + 1ull) : MAX_V;
-            const ULOW W2 = MAX_V - get_quotient(Delta, C1);
-
-            UBig Quotient = get_quotient(get_quotient(W1, W2), C1);
-            if (is_neg)
-                Quotient = -Quotient;
-
-            // 4. Формирование итогового частного (только младшая часть, т.к. private case)
-            UBig result = UBig{Q} + Quotient - UBig{is_neg ? 1ull : 0ull};
-
-            // 5. Финальная коррекция (обычно 0-1 итерация)
-            // Используем N для вычисления точного остатка
-            UBig N = other * result.mLow;
-
-            // Если переоценили (result > истинного)
-            while (*this < N)
-            {
-                result.dec();
-                N -= other;
-            }
-
-            UBig Remainder = *this - N;
+            assert(divisor != UBig{0});
+            const auto b = divisor.to_limbs();
+            std::array<uint64_t, LIMBS> q{}, r{};
+            divide_limbs(dividend.to_limbs(), b.data(), LIMBS, Q ? q.data() : nullptr, R ? r.data() : nullptr);
+            if constexpr (R)
+                *rem_out = from_limbs(r);
+            return from_limbs(q);
+        }
 
-            // Если недооценили (result < истинного)
-            while (Remainder >= other)
+        /**
+         * @brief Деление на "половинку" с выбором вычисляемых величин на этапе компиляции (UBig / ULOW).
+         * @param rem_out Остаток (используется при R = true).
+         * @return Частное (ноль при Q = false).
+         */
+        template <bool Q, bool R>
+        static constexpr UBig divide(const UBig &dividend, const ULOW &divisor, ULOW *rem_out)
+        {
+            assert(divisor != ULOW{0});
+            using HalfLimbs = std::array<uint64_t, LIMBS / 2>;
+            static_assert(sizeof(ULOW) == sizeof(HalfLimbs));
+            const auto b = std::bit_cast<HalfLimbs>(divisor);
+            std::array<uint64_t, LIMBS> q{}, r{};
+            divide_limbs(dividend.to_limbs(), b.data(), LIMBS / 2, Q ? q.data() : nullptr, R ? r.data() : nullptr);
+            if constexpr (R)
             {
-                Remainder -= other;
-                result.inc();
+                HalfLimbs rem;
+                std::copy_n(r.data(), LIMBS / 2, rem.data());
+                *rem_out = std::bit_cast<ULOW>(rem);
             }
+            return from_limbs(q);
+        }
 
-            return {result, Remainder};
+        /**
+         * @brief Оператор деления.
+         * @return Частное от деления и остаток.
+         */
+        constexpr std::pair<UBig, UBig> operator/(const UBig &other) const
+        {
+            UBig r;
+            const UBig q = divide<true, true>(*this, other, &r);
+            return {q, r};
         }
 
         /**
@@ -397,80 +730,42 @@ namespace bignum
          */
         constexpr std::pair<UBig, ULOW> operator/(const ULOW &other) const
         {
-            assert(other != ULOW{0});
-
-            if (other == ULOW{1})
-                return {*this, ULOW{0}};
-            if (mHigh == ULOW{0})
-            {
-                auto [q, r] = divide_as_pair(mLow, other);
-                return {UBig(q), r};
-            }
-
-            // --- Авторский итеративный метод ---
-            UBig X = *this;
-            const UBig X_old = X;
-            UBig Q{0};
-            ULOW R{0};
-
-            // Вычисляем обратную величину через вашу обобщенную функцию
-            std::pair<ULOW, ULOW> rcp = bignum::generic::reciprocal_and_extend(other);
-            const ULOW rcp_compl = other - rcp.second;
-
-            // Ускорение сходимости (выбор направления коррекции)
-            const bool make_inverse = rcp_compl < rcp.second;
-            if (make_inverse)
-                ++(rcp.first);
-
-            for (;;)
-            {
-                const bool x_has_high = (X.mHigh != ULOW{0});
-
-                // 1. Накапливаем частное
-                if (x_has_high)
-                    Q += mult_ext(X.mHigh, rcp.first);
-
-                // Добавляем результат деления младшей части
-                Q += UBig(get_quotient(X.mLow, other));
-
-                // 2. Считаем остаток через вашу функцию adder
-                const ULOW carry = bignum::generic::smart_remainder_adder(R, X.mLow, other, rcp.second);
-                Q += UBig(carry);
+            ULOW r;
+            const UBig q = divide<true, true>(*this, other, &r);
+            return {q, r};
+        }
 
-                // 3. Обновляем X для следующей итерации
-                if (x_has_high)
-                {
-                    X = mult_ext(X.mHigh, make_inverse ? rcp_compl : rcp.second);
-                }
-                else
-                {
-                    X = UBig{0};
-                }
+        /**
+         * @brief Деление на 64-битное слово по предвычисленной обратной величине делителя (limbs::divrem_u64).
+         * @return Частное и остаток.
+         */
+        constexpr std::pair<UBig, uint64_t> divrem_u64(uint64_t d) const
+        {
+            assert(d != 0);
+            auto q = to_limbs();
+            const size_t n = bignum::limbs::normalized_size(q.data(), LIMBS);
+            const uint64_t r = bignum::limbs::divrem_u64(q.data(), q.data(), n, d);
+            return {from_limbs(q), r};
+        }
 
-                if (X != UBig{0})
-                {
-                    if (make_inverse)
-                    {
-                        Q = -Q;
-                        R = other - R;
-                    }
-                    continue;
-                }
+        /**
+         * @brief Остаток от деления на 64-битное слово, например, при пробном делении на малые простые.
+         */
+        constexpr uint64_t mod_u64(uint64_t d) const
+        {
+            assert(d != 0);
+            const auto a = to_limbs();
+            return bignum::limbs::divrem_u64(nullptr, a.data(), bignum::limbs::normalized_size(a.data(), LIMBS), d);
+        }
 
-                // 4. Финальная коррекция знака
-                if (Q > X_old)
-                {
-                    Q = -Q;
-                    R = other - R;
-                    if (R == other)
-                    {
-                        R = ULOW{0};
-                        Q.inc();
-                    }
-                }
-                break;
-            }
-            return {Q, R};
+        /**
+         * @brief Остаток от деления (частное не сохраняется).
+         */
+        constexpr UBig operator%(const UBig &other) const
+        {
+            UBig r;
+            divide<false, true>(*this, other, &r);
+            return r;
         }
 
         /**
@@ -592,118 +887,194 @@ namespace bignum
         }
 
         /**
-         * @brief Вспомогательный метод для получения только частного.
+         * @brief Применим ли метод Карацубы: разрядность не ниже порога, и половинка сама составная (UBig).
          */
-        static constexpr UBig get_quotient(const UBig &a, const ULOW &b)
+        static consteval bool use_karatsuba() noexcept
         {
-            return (a / b).first;
+            if constexpr (WIDTH >= KARATSUBA_THRESHOLD_BITS)
+                return requires(const ULOW &v) { typename ULOW::value_type; ULOW::mult_ext(v.low(), v.high()); ULOW::square_ext(v.low()); };
+            else
+                return false;
         }
 
         /**
-         * @brief Вспомогательный метод для получения только частного.
+         * @brief Сборка результата метода Карацубы: z0 + (z0 + z2 -+ d) * 2^(N/4) + z2 * 2^(N/2).
+         * @param subtract Вычитать ли d из средней части (иначе прибавлять).
          */
-        static constexpr ULOW get_quotient(const ULOW &a, const ULOW &b)
+        static constexpr UBig karatsuba_combine(const ULOW &z0, const ULOW &z2, const ULOW &d, bool subtract) noexcept
         {
-            return bignum::generic::div_rem(a, b).first;
+            using UQ = typename ULOW::value_type;
+            ULOW mid = z0 + z2;
+            bool carry = mid < z0;
+            if (subtract)
+            {
+                // Средняя часть неотрицательна, поэтому заем возможен только при наличии переноса.
+                const bool borrow = mid < d;
+                mid -= d;
+                carry = carry && !borrow;
+            }
+            else
+            {
+                mid += d;
+                carry = carry || mid < d;
+            }
+            UBig result{z0, z2};
+            const ULOW mid_low{UQ{0}, mid.low()};
+            result.mLow += mid_low;
+            if (result.mLow < mid_low)
+                ++result.mHigh;
+            result.mHigh += ULOW{mid.high(), UQ{carry ? 1u : 0u}};
+            return result;
         }
 
         /**
-         * @brief Вспомогательный метод для получения частного и остатка в виде пары.
+         * @brief Старшая половина произведения через половинки: x1 * y1 + (x1 * y0 + x0 * y1 + h) / 2^(N/2),
+         * где h = mulhi(x0, y0) при exact и h = 0 иначе.
          */
-        static constexpr auto divide_as_pair(const ULOW &a, const ULOW &b)
+        static constexpr UBig mulhi_hierarchical(const UBig &x, const UBig &y, bool exact) noexcept
         {
-            return bignum::generic::div_rem(a, b);
+            const UBig a = UBig::mult_ext(x.mHigh, y.mLow);
+            const UBig b = UBig::mult_ext(x.mLow, y.mHigh);
+            UBig mid = a + b;
+            uint64_t carry = mid < a ? 1 : 0;
+            if (exact)
+            {
+                UBig h;
+                if constexpr (std::is_same_v<ULOW, u128::U128>)
+                    h = UBig{u128::mulhi(x.mLow, y.mLow)};
+                else
+                    h = UBig{ULOW::mulhi(x.mLow, y.mLow)};
+                mid += h;
+                carry += mid < h ? 1 : 0;
+            }
+            UBig result = UBig::mult_ext(x.mHigh, y.mHigh);
+            result += UBig{mid.mHigh, ULOW{carry}};
+            return result;
         }
 
         /**
-         * @brief Рекурсивное преобразование в десятичную строку.
-         * Использует деление всего числа на 10^18 для точности.
+         * @brief Проверка того, что память числа - непрерывный массив 64-битных слов без дополнительных полей.
+         * @details Общее допущение библиотеки: UBig любой разрядности (как и U128) хранит половинки подряд,
+         * младшую первой, без выравнивающих вставок, и его память читается и пишется как массив из LIMBS слов.
+         * Формально стандарт не разрешает адресную арифметику через границу подобъектов mLow и mHigh, поэтому
+         * limbs() опирается на поведение поддерживаемых компиляторов (GCC, Clang, MSVC), а здесь проверяется все,
+         * что проверяемо статически. В constexpr-вычислениях используется только пара to_limbs() / from_limbs()
+         * (std::bit_cast); вне их limbs() избавляет сложение, вычитание и сдвиги от трех копий числа на операцию.
          */
-        [[nodiscard]] std::string toString() const
+        static constexpr void check_flat_layout() noexcept
         {
-            if (mHigh == ULOW{0} && mLow == ULOW{0})
-                return "0";
+            static_assert(sizeof(UBig) == LIMBS * sizeof(uint64_t));
+            static_assert(alignof(UBig) == alignof(uint64_t));
+            static_assert(std::is_trivially_copyable_v<UBig>);
+            static_assert(std::is_standard_layout_v<UBig>);
+        }
 
-            UBig copy = *this;
-            std::string final_res = "";
+        /**
+         * @brief Сдвиг влево над "плоским" представлением: сначала на целые слова, затем на остаток бит.
+         */
+        void shift_left_flat(uint32_t s) noexcept
+        {
+            const auto a = limbs();
+            const size_t words = std::min<size_t>(s / 64, LIMBS);
+            std::copy_backward(a.begin(), a.end() - words, a.end());
+            std::fill_n(a.begin(), words, 0);
+            if (words < LIMBS && s % 64 != 0)
+                bignum::limbs::lshift(a.data() + words, a.data() + words, LIMBS - words, s % 64);
+        }
 
-            // Используем 10^18 как базу. Она гарантированно влезает в uint64_t
-            // и позволяет удобно дополнять нулями.
-            const uint64_t base_val = 1000000000000000000ULL;
-            const ULOW base_low{base_val};
+        /**
+         * @brief Сдвиг вправо над "плоским" представлением: сначала на целые слова, затем на остаток бит.
+         */
+        void shift_right_flat(uint32_t s) noexcept
+        {
+            const auto a = limbs();
+            const size_t words = std::min<size_t>(s / 64, LIMBS);
+            std::copy(a.begin() + words, a.end(), a.begin());
+            std::fill(a.end() - words, a.end(), 0);
+            if (words < LIMBS && s % 64 != 0)
+                bignum::limbs::rshift(a.data(), a.data(), LIMBS - words, s % 64);
+        }
 
-            while (copy > UBig{0})
+        /**
+         * @brief Деление над "плоским" представлением: q = a / b, r = a mod b, где b - первые nb слов делителя (b != 0).
+         * @param q Частное, LIMBS слов (обнулено заранее), или nullptr.
+         * @param r Остаток, LIMBS слов (обнулено заранее), или nullptr.
+         */
+        static constexpr void divide_limbs(const std::array<uint64_t, LIMBS> &a, const uint64_t *b, size_t nb,
+                                           uint64_t *q, uint64_t *r)
+        {
+            const size_t na = bignum::limbs::normalized_size(a.data(), LIMBS);
+            nb = bignum::limbs::normalized_size(b, nb);
+            if (na < nb)
             {
-                // Вызываем ваше половинчатое деление (UBig / ULOW)
-                // Оно возвращает пару {UBig quotient, ULOW remainder}
-                auto [q, r] = copy / base_low;
-
-                // Превращаем остаток r в строку.
-                // Если ULOW - это u64, используем std::to_string.
-                // Если ULOW - это U128, вызываем r.toString().
-                std::string part;
-                if constexpr (std::is_same_v<ULOW, uint64_t>)
-                {
-                    part = std::to_string(r);
-                }
-                else
-                {
-                    part = r.toString();
-                }
-
-                // Если это не последний (самый старший) кусок,
-                // дополняем его ведущими нулями до 18 знаков.
-                if (q > UBig{0})
+                if (r)
+                    std::copy_n(a.data(), LIMBS, r);
+                return;
+            }
+            if (nb == 1)
+            {
+                const uint64_t rem = bignum::limbs::divrem_u64(q, a.data(), na, b[0]);
+                if (r)
+                    r[0] = rem;
+                return;
+            }
+            if constexpr (LIMBS >= 2 * bignum::limbs::DIV_BZ_THRESHOLD)
+            {
+                if (!std::is_constant_evaluated())
                 {
-                    if (part.length() < 18)
-                    {
-                        part = std::string(18 - part.length(), '0') + part;
-                    }
+                    bignum::limbs::divrem_auto(q, r, a.data(), na, b, nb);
+                    return;
                 }
-
-                final_res = part + final_res;
-                copy = q;
             }
+            std::array<uint64_t, 2 * LIMBS + 1> work{};
+            bignum::limbs::divrem(q, r, a.data(), na, b, nb, work.data());
+        }
 
-            return final_res;
+        /**
+         * @brief Преобразование в десятичную строку.
+         * @details Число переводится в "плоское" представление и записывается в один заранее выделенный буфер
+         * методом "разделяй и властвуй": деление на кэшированные степени 10^(18 * 2^k) (см. limbs::pow10_table),
+         * а короткие части - простым циклом деления на 10^19.
+         */
+        [[nodiscard]] std::string toString() const
+        {
+            const auto limbs = to_limbs();
+            return bignum::limbs::to_decimal_string(limbs.data(), LIMBS, MAX_DIGITS, bignum::limbs::pow10_table<MAX_DIGITS>());
         }
 
+        /**
+         * @brief Разбор десятичной строки (результат по модулю 2^WIDTH); ведущие пробелы и '+' пропускаются.
+         * @details Длинные строки разбираются рекурсивно по дереву степеней десяти, короткие - блоками до 19 цифр
+         * SWAR/SIMD-методом (limbs::parse_decimal).
+         */
         static constexpr UBig fromString(std::string_view s)
         {
-            if (s.empty())
-                return UBig{0};
-
             size_t p = 0;
             while (p < s.length() && (s[p] == ' ' || s[p] == '+'))
                 p++;
+            std::array<uint64_t, LIMBS> limbs;
+            bignum::limbs::parse_decimal(s.data() + p, s.data() + s.length(), limbs.data(), LIMBS,
+                                         &bignum::limbs::pow10_table<MAX_DIGITS>, nullptr);
+            return from_limbs(limbs);
+        }
 
-            UBig res{0};
-
-            // Для U256 (где ULOW=U128) мы можем эффективно
-            // обрабатывать строки блоками по 18 цифр,
-            // используя уже готовый оператор * и + самого UBig.
-            while (p < s.length())
-            {
-                uint64_t block_val = 0;
-                uint64_t multiplier = 1;
-
-                size_t end = std::min(p + 18, s.length());
-                for (; p < end; ++p)
-                {
-                    if (s[p] < '0' || s[p] > '9')
-                        break;
-                    block_val = block_val * 10 + (s[p] - '0');
-                    multiplier *= 10;
-                }
-
-                // Используем арифметику UBig: res = res * multiplier + block_val
-                // multiplier автоматически преобразуется в UBig через конструктор от u64
-                res = (res * UBig(multiplier)) + UBig(block_val);
-
-                if (p < s.length() && (s[p] < '0' || s[p] > '9'))
-                    break;
-            }
-            return res;
+        /**
+         * @brief Чтение десятичного числа из [first, last) по контракту std::from_chars (без знака и пробелов).
+         * @return Указатель на первый неразобранный символ; std::errc::invalid_argument, если цифр нет;
+         * std::errc::result_out_of_range при переполнении (value не изменяется).
+         */
+        friend constexpr std::from_chars_result from_chars(const char *first, const char *last, UBig &value)
+        {
+            std::array<uint64_t, LIMBS> limbs;
+            bool overflow = false;
+            const char *const p = bignum::limbs::parse_decimal(first, last, limbs.data(), LIMBS,
+                                                               &bignum::limbs::pow10_table<MAX_DIGITS>, &overflow);
+            if (p == first)
+                return {first, std::errc::invalid_argument};
+            if (overflow)
+                return {p, std::errc::result_out_of_range};
+            value = from_limbs(limbs);
+            return {p, std::errc{}};
         }
     };
 
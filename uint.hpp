@@ -0,0 +1,477 @@
+/**
+ * @author nawww83@gmail.com
+ * @brief Беззнаковое число фиксированной разрядности, кратной 64 битам (не обязательно степени двойки),
+ * над "плоским" массивом 64-битных слов.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <bit>
+#include <compare>
+#include <algorithm>
+#include <utility>
+#include <array>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <type_traits>
+#include "u128.hpp"
+#include "ubig.hpp"
+#include "limbs.hpp"
+
+namespace bignum
+{
+    namespace detail
+    {
+        /**
+         * @brief Является ли тип иерархическим числом (U128, UBig), память которого - массив 64-битных слов.
+         */
+        template <typename T>
+        inline constexpr bool is_hierarchical_v = false;
+
+        template <>
+        inline constexpr bool is_hierarchical_v<u128::U128> = true;
+
+        template <typename ULOW>
+        inline constexpr bool is_hierarchical_v<UBig<ULOW>> = true;
+
+        /**
+         * @brief Слова иерархического числа, младшее слово первое.
+         */
+        template <typename T>
+        constexpr std::array<uint64_t, sizeof(T) / sizeof(uint64_t)> hierarchical_limbs(const T &x) noexcept
+        {
+            return std::bit_cast<std::array<uint64_t, sizeof(T) / sizeof(uint64_t)>>(x);
+        }
+
+        /**
+         * @brief Сравнение чисел разной длины (недостающие старшие слова считаются нулями).
+         */
+        constexpr std::strong_ordering compare_limbs(const uint64_t *a, size_t na, const uint64_t *b, size_t nb) noexcept
+        {
+            for (size_t i = std::max(na, nb); i-- > 0;)
+            {
+                const uint64_t x = i < na ? a[i] : 0;
+                const uint64_t y = i < nb ? b[i] : 0;
+                if (x != y)
+                    return x <=> y;
+            }
+            return std::strong_ordering::equal;
+        }
+    }
+
+    /**
+     * @brief Беззнаковое число разрядности Bits (кратно 64), например, 192 или 320 бит.
+     * @details В отличие от UBig, разрядность не обязана удваиваться: число занимает ровно Bits / 64 слов.
+     * Арифметика - по модулю 2^Bits, через функции limbs. С U128 и UBig возможны явные преобразования
+     * (с усечением или дополнением нулями) и смешанные сравнения.
+     * @tparam Bits Разрядность.
+     */
+    template <size_t Bits>
+    class UInt
+    {
+        static_assert(Bits > 0 && Bits % 64 == 0, "UInt: разрядность должна быть кратна 64 битам");
+
+    public:
+        static constexpr uint32_t WIDTH = static_cast<uint32_t>(Bits);
+
+        // Количество 64-битных слов.
+        static constexpr size_t LIMBS = Bits / 64;
+
+        // Наибольшее количество десятичных цифр: floor(WIDTH * log10(2)) + 1.
+        static constexpr size_t MAX_DIGITS = static_cast<size_t>(WIDTH) * 30103 / 100000 + 1;
+
+    private:
+        std::array<uint64_t, LIMBS> mLimbs{};
+
+    public:
+        // --- Конструкторы ---
+        constexpr UInt() noexcept = default;
+
+        constexpr UInt(uint64_t val) noexcept : mLimbs{val} {}
+
+        constexpr explicit UInt(std::string_view s)
+        {
+            *this = fromString(s);
+        }
+
+        /**
+         * @brief Преобразование из U128 или UBig: усечение до Bits бит или дополнение нулями.
+         */
+        template <typename T>
+            requires detail::is_hierarchical_v<T>
+        constexpr explicit UInt(const T &x) noexcept
+        {
+            const auto a = detail::hierarchical_limbs(x);
+            std::copy_n(a.data(), std::min(a.size(), LIMBS), mLimbs.data());
+        }
+
+        /**
+         * @brief Преобразование из числа другой разрядности: усечение или дополнение нулями.
+         */
+        template <size_t OtherBits>
+            requires(OtherBits != Bits)
+        constexpr explicit UInt(const UInt<OtherBits> &x) noexcept
+        {
+            std::copy_n(x.to_limbs().data(), std::min(UInt<OtherBits>::LIMBS, LIMBS), mLimbs.data());
+        }
+
+        /**
+         * @brief Преобразование в U128 или UBig: усечение или дополнение нулями.
+         */
+        template <typename T>
+            requires detail::is_hierarchical_v<T>
+        constexpr explicit operator T() const noexcept
+        {
+            std::array<uint64_t, sizeof(T) / sizeof(uint64_t)> a{};
+            std::copy_n(mLimbs.data(), std::min(a.size(), LIMBS), a.data());
+            return std::bit_cast<T>(a);
+        }
+
+        // --- "Плоское" представление ---
+        /**
+         * @brief Копия числа в виде массива 64-битных слов, младшее слово первое.
+         */
+        [[nodiscard]] constexpr const std::array<uint64_t, LIMBS> &to_limbs() const noexcept { return mLimbs; }
+
+        /**
+         * @brief Число из массива 64-битных слов, младшее слово первое.
+         */
+        static constexpr UInt from_limbs(const std::array<uint64_t, LIMBS> &limbs) noexcept
+        {
+            UInt res;
+            res.mLimbs = limbs;
+            return res;
+        }
+
+        /**
+         * @brief Слова числа без копирования, младшее слово первое.
+         */
+        [[nodiscard]] constexpr std::span<uint64_t, LIMBS> limbs() noexcept { return mLimbs; }
+        [[nodiscard]] constexpr std::span<const uint64_t, LIMBS> limbs() const noexcept { return mLimbs; }
+
+        // --- Сравнение ---
+        constexpr bool operator==(const UInt &other) const noexcept = default;
+
+        constexpr std::strong_ordering operator<=>(const UInt &other) const noexcept
+        {
+            return detail::compare_limbs(mLimbs.data(), LIMBS, other.mLimbs.data(), LIMBS);
+        }
+
+        /**
+         * @brief Сравнение с U128 или UBig (по значению, независимо от разрядности).
+         */
+        template <typename T>
+            requires detail::is_hierarchical_v<T>
+        friend constexpr bool operator==(const UInt &x, const T &y) noexcept
+        {
+            return (x <=> y) == 0;
+        }
+
+        template <typename T>
+            requires detail::is_hierarchical_v<T>
+        friend constexpr std::strong_ordering operator<=>(const UInt &x, const T &y) noexcept
+        {
+            const auto b = detail::hierarchical_limbs(y);
+            return detail::compare_limbs(x.mLimbs.data(), LIMBS, b.data(), b.size());
+        }
+
+        // --- Сложение и вычитание ---
+        constexpr UInt &operator+=(const UInt &other) noexcept
+        {
+            bignum::limbs::add_n(mLimbs.data(), mLimbs.data(), other.mLimbs.data(), LIMBS);
+            return *this;
+        }
+
+        constexpr UInt &operator-=(const UInt &other) noexcept
+        {
+            bignum::limbs::sub_n(mLimbs.data(), mLimbs.data(), other.mLimbs.data(), LIMBS);
+            return *this;
+        }
+
+        constexpr UInt operator+(const UInt &other) const noexcept { return UInt(*this) += other; }
+        constexpr UInt operator-(const UInt &other) const noexcept { return UInt(*this) -= other; }
+
+        constexpr UInt &operator++() noexcept
+        {
+            bignum::limbs::add_1(mLimbs.data(), LIMBS, 1);
+            return *this;
+        }
+
+        constexpr UInt &operator--() noexcept
+        {
+            for (size_t i = 0; i < LIMBS && mLimbs[i]-- == 0; ++i)
+                ;
+            return *this;
+        }
+
+        constexpr UInt operator-() const noexcept { return UInt{0} - *this; }
+
+        // --- Умножение ---
+        /**
+         * @brief Умножение по модулю 2^Bits: вычисляются только младшие LIMBS слов произведения.
+         */
+        constexpr UInt operator*(const UInt &other) const noexcept
+        {
+            UInt res;
+            uint64_t *r = res.mLimbs.data();
+            const uint64_t *a = mLimbs.data();
+            const uint64_t *b = other.mLimbs.data();
+            bignum::limbs::mul_1(r, a, LIMBS, b[0]);
+            for (size_t j = 1; j < LIMBS; ++j)
+                bignum::limbs::addmul_1(r + j, a, LIMBS - j, b[j]);
+            return res;
+        }
+
+        constexpr UInt &operator*=(const UInt &other) noexcept { return *this = *this * other; }
+
+        /**
+         * @brief Умножение на слово: x = x * k + c (по модулю 2^Bits) одной цепочкой переносов.
+         * @return Вытесненное старшее слово результата.
+         */
+        constexpr uint64_t mul_add_u64(uint64_t k, uint64_t c) noexcept
+        {
+            return bignum::limbs::mul_add_1(mLimbs.data(), LIMBS, k, c);
+        }
+
+        constexpr uint64_t mul_u64(uint64_t k) noexcept
+        {
+            return bignum::limbs::mul_1(mLimbs.data(), mLimbs.data(), LIMBS, k);
+        }
+
+        constexpr uint64_t add_u64(uint64_t c) noexcept
+        {
+            return bignum::limbs::add_1(mLimbs.data(), LIMBS, c);
+        }
+
+        // --- Деление ---
+        /**
+         * @brief Деление с остатком с выбором вычисляемых величин на этапе компиляции (как UBig::divide).
+         * @param rem_out Остаток (используется при R = true).
+         * @return Частное (ноль при Q = false).
+         */
+        template <bool Q, bool R>
+        static constexpr UInt divide(const UInt &dividend, const UInt &divisor, UInt *rem_out)
+        {
+            assert(divisor != UInt{0});
+            UInt q, r;
+            const size_t na = bignum::limbs::normalized_size(dividend.mLimbs.data(), LIMBS);
+            const size_t nb = bignum::limbs::normalized_size(divisor.mLimbs.data(), LIMBS);
+            if (na < nb)
+            {
+                r = dividend;
+            }
+            else if (!std::is_constant_evaluated() && LIMBS >= 2 * bignum::limbs::DIV_BZ_THRESHOLD)
+            {
+                bignum::limbs::divrem_auto(Q ? q.mLimbs.data() : nullptr, R ? r.mLimbs.data() : nullptr,
+                                           dividend.mLimbs.data(), na, divisor.mLimbs.data(), nb);
+            }
+            else
+            {
+                std::array<uint64_t, 2 * LIMBS + 1> work{};
+                bignum::limbs::divrem(Q ? q.mLimbs.data() : nullptr, R ? r.mLimbs.data() : nullptr,
+                                      dividend.mLimbs.data(), na, divisor.mLimbs.data(), nb, work.data());
+            }
+            if constexpr (R)
+                *rem_out = r;
+            return q;
+        }
+
+        /**
+         * @brief Оператор деления.
+         * @return Частное от деления и остаток.
+         */
+        constexpr std::pair<UInt, UInt> operator/(const UInt &other) const
+        {
+            UInt r;
+            const UInt q = divide<true, true>(*this, other, &r);
+            return {q, r};
+        }
+
+        /**
+         * @brief Остаток от деления (частное не сохраняется).
+         */
+        constexpr UInt operator%(const UInt &other) const
+        {
+            UInt r;
+            divide<false, true>(*this, other, &r);
+            return r;
+        }
+
+        /**
+         * @brief Деление на 64-битное слово по предвычисленной обратной величине делителя.
+         * @return Частное и остаток.
+         */
+        constexpr std::pair<UInt, uint64_t> divrem_u64(uint64_t d) const
+        {
+            assert(d != 0);
+            UInt q = *this;
+            const size_t n = bignum::limbs::normalized_size(q.mLimbs.data(), LIMBS);
+            const uint64_t r = bignum::limbs::divrem_u64(q.mLimbs.data(), q.mLimbs.data(), n, d);
+            return {q, r};
+        }
+
+        constexpr uint64_t mod_u64(uint64_t d) const
+        {
+            assert(d != 0);
+            return bignum::limbs::divrem_u64(nullptr, mLimbs.data(), bignum::limbs::normalized_size(mLimbs.data(), LIMBS), d);
+        }
+
+        // --- Сдвиги ---
+        constexpr UInt &operator<<=(uint32_t s) noexcept
+        {
+            const size_t words = std::min<size_t>(s / 64, LIMBS);
+            std::copy_backward(mLimbs.begin(), mLimbs.end() - words, mLimbs.end());
+            std::fill_n(mLimbs.begin(), words, 0);
+            if (words < LIMBS && s % 64 != 0)
+                bignum::limbs::lshift(mLimbs.data() + words, mLimbs.data() + words, LIMBS - words, s % 64);
+            return *this;
+        }
+
+        constexpr UInt &operator>>=(uint32_t s) noexcept
+        {
+            const size_t words = std::min<size_t>(s / 64, LIMBS);
+            std::copy(mLimbs.begin() + words, mLimbs.end(), mLimbs.begin());
+            std::fill(mLimbs.end() - words, mLimbs.end(), 0);
+            if (words < LIMBS && s % 64 != 0)
+                bignum::limbs::rshift(mLimbs.data(), mLimbs.data(), LIMBS - words, s % 64);
+            return *this;
+        }
+
+        constexpr UInt operator<<(uint32_t s) const noexcept { return UInt(*this) <<= s; }
+        constexpr UInt operator>>(uint32_t s) const noexcept { return UInt(*this) >>= s; }
+
+        // --- Логика ---
+        constexpr UInt &operator&=(const UInt &other) noexcept
+        {
+            for (size_t i = 0; i < LIMBS; ++i)
+                mLimbs[i] &= other.mLimbs[i];
+            return *this;
+        }
+
+        constexpr UInt &operator|=(const UInt &other) noexcept
+        {
+            for (size_t i = 0; i < LIMBS; ++i)
+                mLimbs[i] |= other.mLimbs[i];
+            return *this;
+        }
+
+        constexpr UInt &operator^=(const UInt &other) noexcept
+        {
+            for (size_t i = 0; i < LIMBS; ++i)
+                mLimbs[i] ^= other.mLimbs[i];
+            return *this;
+        }
+
+        constexpr UInt operator&(const UInt &other) const noexcept { return UInt(*this) &= other; }
+        constexpr UInt operator|(const UInt &other) const noexcept { return UInt(*this) |= other; }
+        constexpr UInt operator^(const UInt &other) const noexcept { return UInt(*this) ^= other; }
+
+        constexpr UInt operator~() const noexcept
+        {
+            UInt res;
+            for (size_t i = 0; i < LIMBS; ++i)
+                res.mLimbs[i] = ~mLimbs[i];
+            return res;
+        }
+
+        constexpr explicit operator bool() const noexcept { return *this != UInt{0}; }
+
+        // --- Битовые функции ---
+        /**
+         * @brief Количество ведущих нулей.
+         */
+        [[nodiscard]] constexpr uint32_t countl_zero() const noexcept
+        {
+            for (size_t i = LIMBS; i-- > 0;)
+            {
+                if (mLimbs[i] != 0)
+                    return static_cast<uint32_t>((LIMBS - 1 - i) * 64 + std::countl_zero(mLimbs[i]));
+            }
+            return WIDTH;
+        }
+
+        /**
+         * @brief Количество младших нулей.
+         */
+        [[nodiscard]] constexpr uint32_t countr_zero() const noexcept
+        {
+            for (size_t i = 0; i < LIMBS; ++i)
+            {
+                if (mLimbs[i] != 0)
+                    return static_cast<uint32_t>(i * 64 + std::countr_zero(mLimbs[i]));
+            }
+            return WIDTH;
+        }
+
+        /**
+         * @brief Количество единичных бит.
+         */
+        [[nodiscard]] constexpr uint32_t popcount() const noexcept
+        {
+            uint32_t count = 0;
+            for (uint64_t limb : mLimbs)
+                count += static_cast<uint32_t>(std::popcount(limb));
+            return count;
+        }
+
+        [[nodiscard]] constexpr uint32_t bit_width() const noexcept { return WIDTH - countl_zero(); }
+
+        [[nodiscard]] static constexpr UInt max() noexcept { return ~UInt{0}; }
+
+        [[nodiscard]] static constexpr UInt min() noexcept { return UInt{0}; }
+
+        // --- Строки ---
+        /**
+         * @brief Преобразование в десятичную строку (как UBig::toString).
+         */
+        [[nodiscard]] std::string toString() const
+        {
+            return bignum::limbs::to_decimal_string(mLimbs.data(), LIMBS, MAX_DIGITS, bignum::limbs::pow10_table<MAX_DIGITS>());
+        }
+
+        /**
+         * @brief Разбор десятичной строки (результат по модулю 2^Bits).
+         */
+        static constexpr UInt fromString(std::string_view s)
+        {
+            size_t p = 0;
+            while (p < s.length() && (s[p] == ' ' || s[p] == '+'))
+                p++;
+            UInt res;
+            bignum::limbs::parse_decimal(s.data() + p, s.data() + s.length(), res.mLimbs.data(), LIMBS,
+                                         &bignum::limbs::pow10_table<MAX_DIGITS>, nullptr);
+            return res;
+        }
+    };
+
+    /**
+     * @brief Произведение с расширением разрядности: UInt<B1> * UInt<B2> -> UInt<B1 + B2>, например, 192 x 128 -> 320 бит.
+     */
+    template <size_t B1, size_t B2>
+    constexpr UInt<B1 + B2> mult_ext(const UInt<B1> &a, const UInt<B2> &b)
+    {
+        std::array<uint64_t, UInt<B1 + B2>::LIMBS> r{};
+        const auto &x = a.to_limbs();
+        const auto &y = b.to_limbs();
+        if (std::is_constant_evaluated())
+        {
+            bignum::limbs::mul_basecase(r.data(), x.data(), x.size(), y.data(), y.size());
+        }
+        else
+        {
+            if constexpr (B1 >= B2)
+                bignum::limbs::mul(r.data(), x.data(), x.size(), y.data(), y.size());
+            else
+                bignum::limbs::mul(r.data(), y.data(), y.size(), x.data(), x.size());
+        }
+        return UInt<B1 + B2>::from_limbs(r);
+    }
+
+    using U192 = UInt<192>;
+    using U320 = UInt<320>;
+
+} // namespace bignum
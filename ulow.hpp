@@ -67,11 +67,18 @@ namespace low64
         /**
          * @brief Оператор умножения (ULOW * UBig).
          * Использует концепт C++20, чтобы не перехватывать лишние типы.
+         * Если тип умеет умножаться на слово (mul_u64), произведение считается одной цепочкой переносов.
          */
         template <typename T>
-        requires requires(T t, ULOW u) { t * u; }
+        requires requires(T t, ULOW u) { t * u; } || requires(T t, uint64_t k) { t.mul_u64(k); }
         [[nodiscard]] constexpr T operator*(const T& rhs) const {
-            return rhs * (*this);
+            if constexpr (requires(T t, uint64_t k) { t.mul_u64(k); }) {
+                T res = rhs;
+                res.mul_u64(mValue);
+                return res;
+            } else {
+                return rhs * (*this);
+            }
         }
 
         template <typename T>